@@ -120,8 +120,36 @@ static const unsigned char temp_binary_data_1[] =
 "out vec4 outColor;\r\n"
 "uniform sampler2D tex;\r\n"
 "uniform sampler2D mask;\r\n"
-"uniform vec4 borderSoft;\r\n"
-"uniform int invertMask;\r\n"
+"#ifdef SURFACE_BAKE\r\n"
+"out vec4 outWarpMask;\r\n"
+"uniform float bakeId;\r\n"
+"#endif\r\n"
+"#ifdef SURFACE_BATCH\r\n"
+"flat in int SurfaceIndex;\r\n"
+"struct SurfaceParams\r\n"
+"{\r\n"
+"\tvec4 borderSoft;\r\n"
+"\tint invertMask;\r\n"
+"\tfloat ratio;\r\n"
+"\tint bezierMode;\r\n"
+"\tint alphaMode;\r\n"
+"\tvec4 bezierPoints[6];\r\n"
+"};\r\n"
+"layout(std140) uniform SurfaceBatchParams\r\n"
+"{\r\n"
+"\tSurfaceParams surfaces[MAX_SURFACES];\r\n"
+"};\r\n"
+"#else\r\n"
+"layout(std140) uniform SurfaceParams\r\n"
+"{\r\n"
+"\tvec4 borderSoft;\r\n"
+"\tint invertMask;\r\n"
+"\tfloat ratio;\r\n"
+"\tint bezierMode;\r\n"
+"\tint alphaMode;\r\n"
+"\tvec4 bezierPoints[6];\r\n"
+"};\r\n"
+"#endif\r\n"
 "\r\n"
 "float map(float value, float min1, float max1, float min2, float max2) {\r\n"
 "\treturn min2 + ((max2-min2)*(value-min1)/(max1-min1)); \r\n"
@@ -129,19 +157,39 @@ static const unsigned char temp_binary_data_1[] =
 "\r\n"
 "void main()\r\n"
 "{\r\n"
-"\toutColor = textureProj(tex, Texcoord);\r\n"
+"#ifdef SURFACE_BATCH\r\n"
+"\tvec4 borderSoft = surfaces[SurfaceIndex].borderSoft;\r\n"
+"\tint invertMask = surfaces[SurfaceIndex].invertMask;\r\n"
+"\tint alphaMode = surfaces[SurfaceIndex].alphaMode;\r\n"
+"#endif\r\n"
 "    vec2 tex2D = Texcoord.xy / Texcoord.z;\r\n"
-"    if (tex2D.x>1 || tex2D.x<0 ||tex2D.y>1 || tex2D.y<0) \r\n"
-"    { outColor = vec4(0,0,0,0); }\r\n"
-"   \tvec4 maskColor = textureProj(mask, Maskcoord);\r\n"
 "   \tfloat alpha = 1.0f;\r\n"
+"\t// alphaMode 1 : soft edges, mask and inversion are precomputed in the mask texture, in surface coordinates\r\n"
+"\tif (alphaMode == 0)\r\n"
+"\t{\r\n"
 "   \tif (SurfacePosition[1] > 1-borderSoft[0])    {alpha *= map(SurfacePosition[1],1.0f,1-borderSoft[0],0.0f,1.0f);} // top\r\n"
 "   \tif (SurfacePosition[0] > 1.0f-borderSoft[1]) {alpha *= map(SurfacePosition[0], 1.0f, 1 - borderSoft[1], 0.0f, 1.0f); } // right\r\n"
 "   \tif (SurfacePosition[1] < borderSoft[2])      {alpha *= map(SurfacePosition[1],0.0f,borderSoft[2],0.0f,1.0f);} // bottom\r\n"
 "   \tif (SurfacePosition[0] < borderSoft[3])      {alpha *= map(SurfacePosition[0],0.0f,borderSoft[3],0.0f,1.0f);} // left\r\n"
+"\t}\r\n"
+"#ifdef SURFACE_BAKE\r\n"
+"\t// warp map : media coordinates, soft edges and id, then mask coordinates and inversion. Medias are read later\r\n"
+"\toutColor = vec4(tex2D, alpha, bakeId);\r\n"
+"\tif (alphaMode == 1) outWarpMask = vec4(SurfacePosition, 0.0f, 1.0f);\r\n"
+"\telse outWarpMask = vec4(Maskcoord.xy / Maskcoord.z, float(invertMask), 1.0f);\r\n"
+"#else\r\n"
+"\toutColor = textureProj(tex, Texcoord);\r\n"
+"    if (tex2D.x>1 || tex2D.x<0 ||tex2D.y>1 || tex2D.y<0) \r\n"
+"    { outColor = vec4(0,0,0,0); }\r\n"
+"\tif (alphaMode == 1) alpha = texture(mask, SurfacePosition)[1];\r\n"
+"\telse\r\n"
+"\t{\r\n"
+"   \tvec4 maskColor = textureProj(mask, Maskcoord);\r\n"
 "\tfloat maskValue = invertMask == 0 ? maskColor[1] : 1-maskColor[1];\r\n"
 "   \talpha *= maskValue; \r\n"
+"\t}\r\n"
 "   \toutColor[3] = alpha;\r\n"
+"#endif\r\n"
 "};\r\n";
 
 const char* fragmentShaderMainSurface_glsl = (const char*) temp_binary_data_1;
@@ -2489,13 +2537,69 @@ static const unsigned char temp_binary_data_5[] =
 "out vec3 Texcoord;\r\n"
 "out vec3 Maskcoord;\r\n"
 "out vec2 SurfacePosition;\r\n"
+"#ifdef SURFACE_BATCH\r\n"
+"in float surfaceIndex;\r\n"
+"flat out int SurfaceIndex;\r\n"
+"struct SurfaceParams\r\n"
+"{\r\n"
+"    vec4 borderSoft;\r\n"
+"    int invertMask;\r\n"
+"    float ratio;\r\n"
+"    int bezierMode;\r\n"
+"    int alphaMode;\r\n"
+"    vec4 bezierPoints[6];\r\n"
+"};\r\n"
+"layout(std140) uniform SurfaceBatchParams\r\n"
+"{\r\n"
+"    SurfaceParams surfaces[MAX_SURFACES];\r\n"
+"};\r\n"
+"#else\r\n"
+"layout(std140) uniform SurfaceParams\r\n"
+"{\r\n"
+"    vec4 borderSoft;\r\n"
+"    int invertMask;\r\n"
+"    float ratio;\r\n"
+"    int bezierMode;\r\n"
+"    int alphaMode;\r\n"
+"    vec4 bezierPoints[6];\r\n"
+"};\r\n"
+"#endif\r\n"
+"\r\n"
+"vec2 bezier(vec2 a, vec2 b, vec2 c, vec2 d, float t)\r\n"
+"{\r\n"
+"    float mt = 1.0f - t;\r\n"
+"    return mt * mt * mt * a + 3.0f * mt * mt * t * b + 3.0f * mt * t * t * c + t * t * t * d;\r\n"
+"}\r\n"
+"\r\n"
 "void main()\r\n"
 "{\r\n"
+"#ifdef SURFACE_BATCH\r\n"
+"    SurfaceIndex = int(surfaceIndex + 0.5f);\r\n"
+"    int bezierMode = surfaces[SurfaceIndex].bezierMode;\r\n"
+"    vec4 bezierPoints[6] = surfaces[SurfaceIndex].bezierPoints;\r\n"
+"#endif\r\n"
 "    Texcoord = texcoord;\r\n"
 "    Maskcoord = maskcoord;\r\n"
 "    SurfacePosition[0] = (surfacePosition[0]+1.0f)/2.0f;\r\n"
 "    SurfacePosition[1] = (surfacePosition[1]+1.0f)/2.0f;\r\n"
-"    gl_Position = vec4(position,0,1);\r\n"
+"\r\n"
+"    vec2 pos = position;\r\n"
+"    if (bezierMode == 1)\r\n"
+"    {\r\n"
+"        // corners, top and bottom handles, then left and right handles\r\n"
+"        vec2 p[12];\r\n"
+"        for (int i = 0; i < 6; i++) { p[i * 2] = bezierPoints[i].xy; p[i * 2 + 1] = bezierPoints[i].zw; }\r\n"
+"\r\n"
+"        float u = SurfacePosition[0];\r\n"
+"        float v = 1.0f - SurfacePosition[1];\r\n"
+"        vec2 top = bezier(p[0], p[1], p[2], p[3], u);\r\n"
+"        vec2 bottom = bezier(p[4], p[5], p[6], p[7], u);\r\n"
+"        vec2 handleTop = top + mix(p[8] - p[0], p[10] - p[3], u);\r\n"
+"        vec2 handleBottom = bottom + mix(p[9] - p[4], p[11] - p[7], u);\r\n"
+"        pos = bezier(top, handleTop, handleBottom, bottom, v);\r\n"
+"    }\r\n"
+"\r\n"
+"    gl_Position = vec4(pos,0,1);\r\n"
 "};\r\n";
 
 const char* VertexShaderMainSurface_glsl = (const char*) temp_binary_data_5;
@@ -2513,11 +2617,11 @@ const char* getNamedResource (const char* resourceNameUTF8, int& numBytes)
     switch (hash)
     {
         case 0x67012481:  numBytes = 2452; return default_rmplayout;
-        case 0x0ffdf71e:  numBytes = 1226; return fragmentShaderMainSurface_glsl;
+        case 0x0ffdf71e:  numBytes = 2452; return fragmentShaderMainSurface_glsl;
         case 0x0ff5b690:  numBytes = 9170; return fragmentShaderTestGrid_glsl;
         case 0xd4093963:  numBytes = 52976; return icon_png;
         case 0x7536b908:  numBytes = 85942; return testPattern_png;
-        case 0xaecbe392:  numBytes = 381; return VertexShaderMainSurface_glsl;
+        case 0xaecbe392:  numBytes = 1948; return VertexShaderMainSurface_glsl;
         default: break;
     }
 
@@ -12,7 +12,7 @@ namespace BinaryData
     const int            default_rmplayoutSize = 2452;
 
     extern const char*   fragmentShaderMainSurface_glsl;
-    const int            fragmentShaderMainSurface_glslSize = 1226;
+    const int            fragmentShaderMainSurface_glslSize = 2452;
 
     extern const char*   fragmentShaderTestGrid_glsl;
     const int            fragmentShaderTestGrid_glslSize = 9170;
@@ -24,7 +24,7 @@ namespace BinaryData
     const int            testPattern_pngSize = 85942;
 
     extern const char*   VertexShaderMainSurface_glsl;
-    const int            VertexShaderMainSurface_glslSize = 381;
+    const int            VertexShaderMainSurface_glslSize = 1948;
 
     // Number of elements in the namedResourceList and originalFileNames arrays.
     const int namedResourceListSize = 6;
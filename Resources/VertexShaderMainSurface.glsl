@@ -5,11 +5,67 @@ in vec3 maskcoord;
 out vec3 Texcoord;
 out vec3 Maskcoord;
 out vec2 SurfacePosition;
+#ifdef SURFACE_BATCH
+in float surfaceIndex;
+flat out int SurfaceIndex;
+struct SurfaceParams
+{
+    vec4 borderSoft;
+    int invertMask;
+    float ratio;
+    int bezierMode;
+    int alphaMode;
+    vec4 bezierPoints[6];
+};
+layout(std140) uniform SurfaceBatchParams
+{
+    SurfaceParams surfaces[MAX_SURFACES];
+};
+#else
+layout(std140) uniform SurfaceParams
+{
+    vec4 borderSoft;
+    int invertMask;
+    float ratio;
+    int bezierMode;
+    int alphaMode;
+    vec4 bezierPoints[6];
+};
+#endif
+
+vec2 bezier(vec2 a, vec2 b, vec2 c, vec2 d, float t)
+{
+    float mt = 1.0f - t;
+    return mt * mt * mt * a + 3.0f * mt * mt * t * b + 3.0f * mt * t * t * c + t * t * t * d;
+}
+
 void main()
 {
+#ifdef SURFACE_BATCH
+    SurfaceIndex = int(surfaceIndex + 0.5f);
+    int bezierMode = surfaces[SurfaceIndex].bezierMode;
+    vec4 bezierPoints[6] = surfaces[SurfaceIndex].bezierPoints;
+#endif
     Texcoord = texcoord;
     Maskcoord = maskcoord;
     SurfacePosition[0] = (surfacePosition[0]+1.0f)/2.0f;
     SurfacePosition[1] = (surfacePosition[1]+1.0f)/2.0f;
-    gl_Position = vec4(position,0,1);
+
+    vec2 pos = position;
+    if (bezierMode == 1)
+    {
+        // corners, top and bottom handles, then left and right handles
+        vec2 p[12];
+        for (int i = 0; i < 6; i++) { p[i * 2] = bezierPoints[i].xy; p[i * 2 + 1] = bezierPoints[i].zw; }
+
+        float u = SurfacePosition[0];
+        float v = 1.0f - SurfacePosition[1];
+        vec2 top = bezier(p[0], p[1], p[2], p[3], u);
+        vec2 bottom = bezier(p[4], p[5], p[6], p[7], u);
+        vec2 handleTop = top + mix(p[8] - p[0], p[10] - p[3], u);
+        vec2 handleBottom = bottom + mix(p[9] - p[4], p[11] - p[7], u);
+        pos = bezier(top, handleTop, handleBottom, bottom, v);
+    }
+
+    gl_Position = vec4(pos,0,1);
 };
@@ -4,8 +4,36 @@ in vec2 SurfacePosition;
 out vec4 outColor;
 uniform sampler2D tex;
 uniform sampler2D mask;
-uniform vec4 borderSoft;
-uniform int invertMask;
+#ifdef SURFACE_BAKE
+out vec4 outWarpMask;
+uniform float bakeId;
+#endif
+#ifdef SURFACE_BATCH
+flat in int SurfaceIndex;
+struct SurfaceParams
+{
+	vec4 borderSoft;
+	int invertMask;
+	float ratio;
+	int bezierMode;
+	int alphaMode;
+	vec4 bezierPoints[6];
+};
+layout(std140) uniform SurfaceBatchParams
+{
+	SurfaceParams surfaces[MAX_SURFACES];
+};
+#else
+layout(std140) uniform SurfaceParams
+{
+	vec4 borderSoft;
+	int invertMask;
+	float ratio;
+	int bezierMode;
+	int alphaMode;
+	vec4 bezierPoints[6];
+};
+#endif
 
 float map(float value, float min1, float max1, float min2, float max2) {
 	return min2 + ((max2-min2)*(value-min1)/(max1-min1)); 
@@ -13,17 +41,37 @@ float map(float value, float min1, float max1, float min2, float max2) {
 
 void main()
 {
-	outColor = textureProj(tex, Texcoord);
+#ifdef SURFACE_BATCH
+	vec4 borderSoft = surfaces[SurfaceIndex].borderSoft;
+	int invertMask = surfaces[SurfaceIndex].invertMask;
+	int alphaMode = surfaces[SurfaceIndex].alphaMode;
+#endif
     vec2 tex2D = Texcoord.xy / Texcoord.z;
-    if (tex2D.x>1 || tex2D.x<0 ||tex2D.y>1 || tex2D.y<0) 
-    { outColor = vec4(0,0,0,0); }
-   	vec4 maskColor = textureProj(mask, Maskcoord);
    	float alpha = 1.0f;
+	// alphaMode 1 : soft edges, mask and inversion are precomputed in the mask texture, in surface coordinates
+	if (alphaMode == 0)
+	{
    	if (SurfacePosition[1] > 1-borderSoft[0])    {alpha *= map(SurfacePosition[1],1.0f,1-borderSoft[0],0.0f,1.0f);} // top
    	if (SurfacePosition[0] > 1.0f-borderSoft[1]) {alpha *= map(SurfacePosition[0], 1.0f, 1 - borderSoft[1], 0.0f, 1.0f); } // right
    	if (SurfacePosition[1] < borderSoft[2])      {alpha *= map(SurfacePosition[1],0.0f,borderSoft[2],0.0f,1.0f);} // bottom
    	if (SurfacePosition[0] < borderSoft[3])      {alpha *= map(SurfacePosition[0],0.0f,borderSoft[3],0.0f,1.0f);} // left
+	}
+#ifdef SURFACE_BAKE
+	// warp map : media coordinates, soft edges and id, then mask coordinates and inversion. Medias are read later
+	outColor = vec4(tex2D, alpha, bakeId);
+	if (alphaMode == 1) outWarpMask = vec4(SurfacePosition, 0.0f, 1.0f);
+	else outWarpMask = vec4(Maskcoord.xy / Maskcoord.z, float(invertMask), 1.0f);
+#else
+	outColor = textureProj(tex, Texcoord);
+    if (tex2D.x>1 || tex2D.x<0 ||tex2D.y>1 || tex2D.y<0) 
+    { outColor = vec4(0,0,0,0); }
+	if (alphaMode == 1) alpha = texture(mask, SurfacePosition)[1];
+	else
+	{
+   	vec4 maskColor = textureProj(mask, Maskcoord);
 	float maskValue = invertMask == 0 ? maskColor[1] : 1-maskColor[1];
    	alpha *= maskValue; 
+	}
    	outColor[3] = alpha;
+#endif
 };
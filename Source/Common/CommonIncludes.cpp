@@ -13,9 +13,21 @@
 #include "NDI/NDIDevice.cpp"
 #include "NDI/NDIDeviceParameter.cpp"
 #include "NDI/NDIManager.cpp"
+#include "NDI/NDIOutput.cpp"
 #include "NDI/ui/NDIDeviceChooser.cpp"
 #include "NDI/ui/NDIDeviceParameterUI.cpp"
 
+#include "QuadBatcher.cpp"
+#include "RenderGraph.cpp"
+#include "StatsPublisher.cpp"
+#include "RenderTimer.cpp"
+#include "PresentTimer.cpp"
+#include "GPUReadback.cpp"
+#include "FrameScheduler.cpp"
+#include "HeadlessGLContext.cpp"
+#include "FrameBufferPool.cpp"
+#include "FrameHandoff.cpp"
+#include "GLProductionContext.cpp"
 #include "OpenGLManager.cpp"
 
 #include "MediaTarget.cpp"
@@ -25,12 +25,24 @@
 
 #include "NDI/NDIDevice.h"
 #include "NDI/NDIManager.h"
+#include "NDI/NDIOutput.h"
 #include "NDI/NDIDeviceParameter.h"
 
 #include "NDI/ui/NDIDeviceChooser.h"
 #include "NDI/ui/NDIDeviceParameterUI.h"
 
 #include "GLHelpers.h"
+#include "QuadBatcher.h"
+#include "RenderGraph.h"
+#include "StatsPublisher.h"
+#include "RenderTimer.h"
+#include "PresentTimer.h"
+#include "GPUReadback.h"
+#include "FrameScheduler.h"
+#include "HeadlessGLContext.h"
+#include "FrameBufferPool.h"
+#include "FrameHandoff.h"
+#include "GLProductionContext.h"
 #include "OpenGLManager.h"
 
 #include "MediaTarget.h"
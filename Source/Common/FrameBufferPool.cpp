@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+	FrameBufferPool.cpp
+	Created: 16 Oct 2026 10:05:47pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+FrameBufferPool::FrameBufferPool(OpenGLContext& context, FrameScheduler& scheduler) :
+	context(context),
+	scheduler(scheduler)
+{
+}
+
+FrameBufferPool::~FrameBufferPool()
+{
+}
+
+FrameBufferPool::Buffer::Ptr FrameBufferPool::acquire(int width, int height)
+{
+	if (width <= 0 || height <= 0) return nullptr;
+
+	{
+		GenericScopedLock lock(buffers.getLock());
+		for (auto& b : buffers)
+		{
+			//only the pool holds it, free to recycle
+			if (b->getReferenceCount() > 1) continue;
+			if (b->frameBuffer.getWidth() != width || b->frameBuffer.getHeight() != height) continue;
+
+			b->lastUsedTick = scheduler.numTicks;
+			return b;
+		}
+	}
+
+	Buffer::Ptr b = new Buffer();
+	if (!b->frameBuffer.initialise(context, width, height)) return nullptr;
+	b->lastUsedTick = scheduler.numTicks;
+	buffers.add(b);
+
+	return b;
+}
+
+void FrameBufferPool::trim(int64 tick)
+{
+	GenericScopedLock lock(buffers.getLock());
+	for (int i = buffers.size() - 1; i >= 0; i--)
+	{
+		Buffer* b = buffers[i].get();
+		if (b->getReferenceCount() > 1)
+		{
+			b->lastUsedTick = tick;
+			continue;
+		}
+
+		if (tick - b->lastUsedTick < maxUnusedTicks) continue;
+
+		b->frameBuffer.release();
+		buffers.remove(i);
+	}
+}
+
+void FrameBufferPool::clear()
+{
+	//buffers still referenced are invalidated, their owner will acquire a new one on next use
+	GenericScopedLock lock(buffers.getLock());
+	for (auto& b : buffers) b->frameBuffer.release();
+	buffers.clear();
+}
+
+
+
+// PooledFrameBuffer
+
+bool PooledFrameBuffer::initialise(int width, int height)
+{
+	release();
+	buffer = GlContextHolder::getInstance()->getFrameBufferPool().acquire(width, height);
+	return buffer != nullptr;
+}
+
+void PooledFrameBuffer::release()
+{
+	buffer = nullptr;
+}
+
+bool PooledFrameBuffer::isValid() const
+{
+	return buffer != nullptr && buffer->frameBuffer.isValid();
+}
+
+int PooledFrameBuffer::getWidth() const
+{
+	return isValid() ? buffer->frameBuffer.getWidth() : 0;
+}
+
+int PooledFrameBuffer::getHeight() const
+{
+	return isValid() ? buffer->frameBuffer.getHeight() : 0;
+}
+
+GLuint PooledFrameBuffer::getTextureID() const
+{
+	return isValid() ? buffer->frameBuffer.getTextureID() : 0;
+}
+
+GLuint PooledFrameBuffer::getFrameBufferID() const
+{
+	return isValid() ? buffer->frameBuffer.getFrameBufferID() : 0;
+}
+
+bool PooledFrameBuffer::makeCurrentRenderingTarget()
+{
+	return isValid() && buffer->frameBuffer.makeCurrentRenderingTarget();
+}
+
+void PooledFrameBuffer::releaseAsRenderingTarget()
+{
+	if (isValid()) buffer->frameBuffer.releaseAsRenderingTarget();
+}
+
+OpenGLFrameBuffer* PooledFrameBuffer::get() const
+{
+	return buffer != nullptr ? &buffer->frameBuffer : nullptr;
+}
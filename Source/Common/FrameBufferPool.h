@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+	FrameBufferPool.h
+	Created: 16 Oct 2026 10:05:47pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Size-keyed pool of framebuffers (and their RGBA texture) shared by all renderers.
+// A buffer is in use as long as a PooledFrameBuffer references it, released buffers are recycled
+// for the next request of the same size and only deleted after staying unused for a while.
+// Framebuffer objects are not shared between contexts, so each GL context has its own pool.
+class FrameBufferPool
+{
+public:
+	FrameBufferPool(OpenGLContext& context, FrameScheduler& scheduler);
+	~FrameBufferPool();
+
+	OpenGLContext& context;
+	FrameScheduler& scheduler;
+
+	class Buffer :
+		public ReferenceCountedObject
+	{
+	public:
+		Buffer() : lastUsedTick(0) {}
+		OpenGLFrameBuffer frameBuffer;
+		int64 lastUsedTick;
+
+		typedef ReferenceCountedObjectPtr<Buffer> Ptr;
+	};
+
+	static const int maxUnusedTicks = 120;
+
+	ReferenceCountedArray<Buffer, CriticalSection> buffers;
+
+	//GL thread
+	Buffer::Ptr acquire(int width, int height);
+	void trim(int64 tick);
+	void clear();
+};
+
+// Drop-in replacement for an OpenGLFrameBuffer member, backed by the pool of the GL thread initialising it.
+// Releasing does not need the GL context, so it is safe from any thread or destructor.
+class PooledFrameBuffer
+{
+public:
+	PooledFrameBuffer() {}
+	~PooledFrameBuffer() {}
+
+	FrameBufferPool::Buffer::Ptr buffer;
+
+	bool initialise(int width, int height);
+	void release();
+
+	bool isValid() const;
+	int getWidth() const;
+	int getHeight() const;
+	GLuint getTextureID() const;
+	GLuint getFrameBufferID() const;
+
+	bool makeCurrentRenderingTarget();
+	void releaseAsRenderingTarget();
+
+	OpenGLFrameBuffer* get() const;
+};
@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+	FrameHandoff.cpp
+	Created: 17 Oct 2026 1:26:40am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+using namespace juce::gl;
+
+Array<FrameHandoff*> FrameHandoff::handoffs;
+SpinLock FrameHandoff::handoffsLock;
+
+FrameHandoff::FrameHandoff() :
+	numPublished(0),
+	publishedIndex(-1),
+	previousIndex(-1)
+{
+	for (int i = 0; i < numFrames; i++)
+	{
+		fences[i] = nullptr;
+		frameNumbers[i] = -1;
+		publishTimes[i] = 0;
+	}
+
+	GenericScopedLock lock(handoffsLock);
+	handoffs.add(this);
+}
+
+FrameHandoff::~FrameHandoff()
+{
+	{
+		GenericScopedLock lock(handoffsLock);
+		handoffs.removeFirstMatchingValue(this);
+	}
+
+	//not released by a closing context, the fences and buffers go to the GL thread like the surface buffers.
+	//Buffers only return to the pool once the readers are done with them
+	Array<GLsync> syncs;
+	Array<GLsync> readSyncs;
+	Array<FrameBufferPool::Buffer::Ptr> buffers;
+	for (int i = 0; i < numFrames; i++)
+	{
+		if (fences[i] != nullptr) syncs.add(fences[i]);
+		readSyncs.addArray(readFences[i]);
+		if (frames[i].buffer != nullptr) buffers.add(frames[i].buffer);
+	}
+
+	if (syncs.isEmpty() && readSyncs.isEmpty() && buffers.isEmpty()) return;
+	if (GlContextHolder::getInstanceWithoutCreating() == nullptr) return;
+
+	GlContextHolder::getInstance()->executeOnGLThread([syncs, readSyncs, buffers]()
+		{
+			//readers fence at the end of their frame, these have almost always signaled already
+			for (auto& f : readSyncs)
+			{
+				glClientWaitSync(f, GL_SYNC_FLUSH_COMMANDS_BIT, 10000000);
+				glDeleteSync(f);
+			}
+
+			for (auto& f : syncs) glDeleteSync(f);
+		}, false);
+}
+
+void FrameHandoff::publish(PooledFrameBuffer& source, int64 frameNumber)
+{
+	if (!source.isValid()) return;
+
+	const int w = source.getWidth();
+	const int h = source.getHeight();
+
+	//oldest slot no reader holds anymore, never the published one. Marked unreadable until it is published again,
+	//so it can't be picked as the previous frame meanwhile
+	int index = -1;
+	{
+		GenericScopedLock lock(publishLock);
+		for (int i = 1; i < numFrames && index < 0; i++)
+		{
+			const int candidate = (publishedIndex + i + numFrames) % numFrames;
+			if (isSlotFree(candidate)) index = candidate;
+		}
+
+		if (index < 0) return;
+		frameNumbers[index] = -1;
+		if (previousIndex == index) previousIndex = -1;
+	}
+
+	//free, so the old buffer can go back to the pool right away
+	PooledFrameBuffer& target = frames[index];
+	if (target.getWidth() != w || target.getHeight() != h)
+	{
+		if (!target.initialise(w, h)) return;
+	}
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, source.getFrameBufferID());
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target.getFrameBufferID());
+	glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	glFlush(); //the fence has to reach the GPU before another context waits on it
+
+	GLsync oldFence = nullptr;
+	{
+		GenericScopedLock lock(publishLock);
+		oldFence = fences[index];
+		fences[index] = fence;
+		frameNumbers[index] = frameNumber >= 0 ? frameNumber : numPublished;
+		numPublished++;
+		publishTimes[index] = Time::getMillisecondCounterHiRes();
+		previousIndex = publishedIndex;
+		publishedIndex = index;
+	}
+
+	if (oldFence != nullptr) glDeleteSync(oldFence);
+}
+
+void FrameHandoff::release()
+{
+	GenericScopedLock lock(publishLock);
+	for (int i = 0; i < numFrames; i++)
+	{
+		if (fences[i] != nullptr) glDeleteSync(fences[i]);
+		fences[i] = nullptr;
+		for (auto& f : readFences[i]) glDeleteSync(f);
+		readFences[i].clearQuick();
+		pendingReaders[i].clearQuick();
+		frames[i].release();
+		frameNumbers[i] = -1;
+	}
+
+	publishedIndex = -1;
+	previousIndex = -1;
+}
+
+GLuint FrameHandoff::getTextureID()
+{
+	int64 frameNumber;
+	double publishTime;
+	return getTextureID(frameNumber, publishTime);
+}
+
+GLuint FrameHandoff::getTextureID(int64& frameNumber, double& publishTime, int64 maxFrameNumber)
+{
+	frameNumber = -1;
+	publishTime = 0;
+
+	GenericScopedLock lock(publishLock);
+	if (publishedIndex < 0) return 0;
+
+	//the previous frame is kept as long as it is read, the producer skips held slots
+	int index = publishedIndex;
+	if (maxFrameNumber >= 0 && frameNumbers[index] > maxFrameNumber && previousIndex >= 0)
+	{
+		if (frameNumbers[previousIndex] >= 0 && frameNumbers[previousIndex] < frameNumbers[index] && frames[previousIndex].isValid()) index = previousIndex;
+	}
+
+	//server side wait, the calling thread goes on and the GPU orders the reads after the copy
+	if (fences[index] != nullptr) glWaitSync(fences[index], 0, GL_TIMEOUT_IGNORED);
+	pendingReaders[index].addIfNotAlreadyThere(Thread::getCurrentThreadId());
+	frameNumber = frameNumbers[index];
+	publishTime = publishTimes[index];
+	return frames[index].getTextureID();
+}
+
+int64 FrameHandoff::getLastFrameNumber()
+{
+	GenericScopedLock lock(publishLock);
+	return publishedIndex < 0 ? -1 : frameNumbers[publishedIndex];
+}
+
+bool FrameHandoff::isSlotFree(int index)
+{
+	if (!pendingReaders[index].isEmpty()) return false;
+
+	for (int i = readFences[index].size() - 1; i >= 0; i--)
+	{
+		if (glClientWaitSync(readFences[index][i], 0, 0) == GL_TIMEOUT_EXPIRED) return false;
+		glDeleteSync(readFences[index][i]);
+		readFences[index].remove(i);
+	}
+
+	return true;
+}
+
+void FrameHandoff::readerFrameDone()
+{
+	const Thread::ThreadID thread = Thread::getCurrentThreadId();
+	bool hasFences = false;
+
+	GenericScopedLock registryLock(handoffsLock);
+	for (auto& h : handoffs)
+	{
+		GenericScopedLock lock(h->publishLock);
+		for (int i = 0; i < numFrames; i++)
+		{
+			if (!h->pendingReaders[i].contains(thread)) continue;
+			h->pendingReaders[i].removeFirstMatchingValue(thread);
+
+			if (GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0))
+			{
+				h->readFences[i].add(fence);
+				hasFences = true;
+			}
+		}
+	}
+
+	//the producer polls them from another context
+	if (hasFences) glFlush();
+}
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+	FrameHandoff.h
+	Created: 17 Oct 2026 1:26:40am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Hands the frames rendered on one GL thread to readers on other threads with a shared context.
+// Each completed frame is copied to a small ring of pooled buffers and fenced, readers always get the last
+// complete copy and only make their own context wait on the GPU for it, so neither side blocks the other.
+// Fences go both ways : a reader thread fences the slots it read at the end of its frame (readerFrameDone),
+// and the producer only writes or resizes a slot once those fences have signaled. If every slot is still read,
+// the frame is not published and the readers keep the previous ones.
+class FrameHandoff
+{
+public:
+	FrameHandoff();
+	~FrameHandoff();
+
+	//published, previous one for frame locked readers, and 2 free to write while readers lag behind
+	static const int numFrames = 4;
+
+	PooledFrameBuffer frames[numFrames];
+	GLsync fences[numFrames];
+	int64 frameNumbers[numFrames]; //-1 while the slot is being written
+	double publishTimes[numFrames];
+	Array<Thread::ThreadID> pendingReaders[numFrames]; //threads that got the slot and did not fence their reads yet
+	Array<GLsync> readFences[numFrames];
+	int64 numPublished;
+	int publishedIndex; //-1 until a frame is published
+	int previousIndex;
+	SpinLock publishLock;
+
+	//producer GL thread, frames are numbered in publish order unless given a number
+	void publish(PooledFrameBuffer& source, int64 frameNumber = -1);
+	void release();
+
+	//reader GL threads, 0 if nothing was published yet
+	GLuint getTextureID();
+	//with a max frame number, the newest of the last 2 published frames not above it, for outputs kept in lockstep
+	GLuint getTextureID(int64& frameNumber, double& publishTime, int64 maxFrameNumber = -1);
+
+	//any thread, -1 if nothing was published yet
+	int64 getLastFrameNumber();
+
+	//reader GL threads, at the end of each frame and when their context closes, after the last draw using a handoff
+	static void readerFrameDone();
+
+private:
+	//publishLock held
+	bool isSlotFree(int index);
+
+	static Array<FrameHandoff*> handoffs;
+	static SpinLock handoffsLock;
+};
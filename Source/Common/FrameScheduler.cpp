@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+	FrameScheduler.cpp
+	Created: 16 Oct 2026 4:18:52pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+FrameScheduler::FrameScheduler() :
+	timeAtTick(0),
+	lastTickTime(0),
+	loopInterval(0),
+	globalFPS(60),
+	numSlots(0),
+	numTicks(0)
+{
+}
+
+FrameScheduler::~FrameScheduler()
+{
+}
+
+void FrameScheduler::tick(double time, int fps)
+{
+	lastTickTime = timeAtTick;
+	timeAtTick = time;
+	globalFPS = fps;
+	numTicks++;
+
+	if (lastTickTime == 0) return;
+
+	double delta = timeAtTick - lastTickTime;
+	loopInterval = loopInterval == 0 ? delta : loopInterval * .9 + delta * .1;
+}
+
+bool FrameScheduler::shouldRender(Slot& slot, int fps)
+{
+	if (globalFPS > 0) fps = fps > 0 ? jmin(fps, globalFPS) : globalFPS;
+	if (fps <= 0) return true;
+
+	const double period = 1000.0 / fps;
+	const double t = timeAtTick;
+
+	if (slot.phase < 0) slot.phase = fmod(numSlots++ * 0.618034, 1.0);
+
+	//first use, rate change or resuming after a long pause (not used, disabled...) : restart the clock
+	if (slot.period != period || slot.nextDeadline == 0 || t > slot.nextDeadline + 1000)
+	{
+		slot.period = period;
+
+		//stagger only slots spanning several loop ticks, by whole ticks so deadlines stay on the tick grid.
+		//A slot running at the loop rate keeps its deadline on a tick and the full jitter margin
+		double offset = 0;
+		if (loopInterval > 0 && period > loopInterval * 1.5)
+		{
+			const int ticksPerPeriod = (int)(period / loopInterval);
+			offset = (int)(slot.phase * ticksPerPeriod) * loopInterval;
+		}
+
+		slot.nextDeadline = t + offset;
+	}
+
+	//render on the tick closest to the deadline, so a limit equal to the loop rate doesn't skip every other frame on jitter
+	const double tolerance = jmin(loopInterval, period) * .5;
+	if (t < slot.nextDeadline - tolerance) return false;
+
+	//deadlines whose window closed before this tick are missed, skip them rather than rendering a burst to catch up
+	if (t > slot.nextDeadline + tolerance)
+	{
+		int missed = (int)((t - tolerance - slot.nextDeadline) / period) + 1;
+		slot.missedDeadlines += missed;
+		slot.nextDeadline += missed * period;
+	}
+
+	slot.nextDeadline += period;
+	return true;
+}
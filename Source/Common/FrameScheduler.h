@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+	FrameScheduler.h
+	Created: 16 Oct 2026 4:18:52pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Decides on each GL loop tick which renderers are due, from deadlines that accumulate
+// by whole periods instead of being reset to the tick time, so rates don't drift or alias against the loop.
+// Every slot gets its own phase, in whole loop ticks, so renderers running slower than the loop don't all land on the same tick.
+class FrameScheduler
+{
+public:
+	FrameScheduler();
+	~FrameScheduler();
+
+	struct Slot
+	{
+		double nextDeadline = 0;
+		double period = 0;
+		double phase = -1; //fraction of the period, assigned on first use
+		int missedDeadlines = 0; //since the slot was first used
+	};
+
+	double timeAtTick;
+	double lastTickTime;
+	double loopInterval; //smoothed time between two loop ticks
+	int globalFPS; //0 for unlimited
+	int numSlots;
+	std::atomic<int64> numTicks; //can be polled from any thread
+
+	//GL thread
+	void tick(double time, int fps);
+	bool shouldRender(Slot& slot, int fps = 0);
+};
@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+	GLProductionContext.cpp
+	Created: 17 Oct 2026 1:02:15am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+GLProductionContext::GLProductionContext(GlContextHolder* holder, juce::Component* parentComponent, juce::OpenGLContext& sharedContext) :
+	holder(holder),
+	frameBufferPool(context, frameScheduler),
+	quadBatcher(context)
+{
+	setInterceptsMouseClicks(false, false);
+	setBounds(0, 0, 1, 1);
+	parentComponent->addAndMakeVisible(this);
+
+	context.setNativeSharedContext(sharedContext.getRawContext());
+	context.setSwapInterval(0);
+	context.setRenderer(this);
+	context.setContinuousRepainting(true);
+	context.setComponentPaintingEnabled(false);
+	context.attachTo(*this);
+}
+
+GLProductionContext::~GLProductionContext()
+{
+	context.detach();
+	context.setRenderer(nullptr);
+}
+
+void GLProductionContext::newOpenGLContextCreated()
+{
+	holder->productionContextCreated();
+}
+
+void GLProductionContext::renderOpenGL()
+{
+	holder->renderProduction();
+}
+
+void GLProductionContext::openGLContextClosing()
+{
+	holder->productionContextClosing();
+}
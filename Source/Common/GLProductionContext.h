@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+	GLProductionContext.h
+	Created: 17 Oct 2026 1:02:15am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class GlContextHolder;
+
+// Second GL context, shared with the main one, rendering all the medias on its own thread so a slow media
+// never holds back the screens and editors. JUCE contexts need a native surface, so it lives in a 1px component
+// of the main window. Framebuffers and vertex arrays are not shared, it has its own pool and quad batcher.
+class GLProductionContext :
+	public juce::Component,
+	private juce::OpenGLRenderer
+{
+public:
+	GLProductionContext(GlContextHolder* holder, juce::Component* parentComponent, juce::OpenGLContext& sharedContext);
+	~GLProductionContext();
+
+	GlContextHolder* holder;
+
+	juce::OpenGLContext context;
+	FrameScheduler frameScheduler;
+	FrameBufferPool frameBufferPool;
+	QuadBatcher quadBatcher;
+
+	void paint(juce::Graphics& g) override {}
+
+private:
+	void newOpenGLContextCreated() override;
+	void renderOpenGL() override;
+	void openGLContextClosing() override;
+};
@@ -0,0 +1,292 @@
+/*
+  ==============================================================================
+
+	GPUReadback.cpp
+	Created: 18 Oct 2026 7:15:44pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+using namespace juce::gl;
+
+GPUReadback::GPUReadback(GlContextHolder* holder) :
+	ControllableContainer("Readback Stats"),
+	Thread("GPU Readback"),
+	holder(holder),
+	inFlightCount(0),
+	completedBytes(0),
+	completedCount(0),
+	latencySum(0),
+	droppedCount(0),
+	lastPublishedBytes(0),
+	lastPublishedCount(0),
+	lastPublishedLatency(0),
+	lastPublishTime(0)
+{
+	queueDepth = addIntParameter("Queue Depth", "Number of readbacks waiting for the GPU or for their callback", 0, 0);
+	bandwidth = addFloatParameter("Bandwidth", "Data read back from the GPU, in MB per second", 0, 0);
+	latency = addFloatParameter("Latency", "Average time from a readback being requested to its callback, in milliseconds", 0, 0);
+	droppedRequests = addIntParameter("Dropped Requests", "Number of readbacks dropped because all the buffers were busy, since the start", 0, 0);
+
+	for (auto& c : controllables)
+	{
+		c->isSavable = false;
+		c->enabled = false;
+	}
+
+	StatsPublisher::getInstance()->addSource(this);
+	startThread();
+}
+
+GPUReadback::~GPUReadback()
+{
+	if (StatsPublisher::getInstanceWithoutCreating() != nullptr) StatsPublisher::getInstance()->removeSource(this);
+	if (parentContainer != nullptr) parentContainer->removeChildControllableContainer(this);
+
+	signalThreadShouldExit();
+	notify();
+	stopThread(1000);
+}
+
+GPUReadback::Ring& GPUReadback::getCurrentRing()
+{
+	return holder->isProductionThread() ? productionRing : mainRing;
+}
+
+bool GPUReadback::request(GLuint texture, const Rectangle<int>& area, Format format, Callback callback)
+{
+	if (texture == 0 || area.isEmpty()) return false;
+
+	Ring& ring = getCurrentRing();
+
+	Slot* slot = nullptr;
+	for (int i = 0; i < numSlots && slot == nullptr; i++)
+	{
+		Slot& s = ring.slots[(ring.nextSlot + i) % numSlots];
+		if (s.state == Slot::FREE) slot = &s;
+	}
+
+	if (slot == nullptr)
+	{
+		droppedCount++;
+		return false;
+	}
+
+	ring.nextSlot = (int)(slot - ring.slots + 1) % numSlots;
+
+	GLenum glFormat, glType;
+	int bytesPerPixel;
+	getGLFormat(format, glFormat, glType, bytesPerPixel);
+
+	const int lineStride = area.getWidth() * bytesPerPixel;
+	slot->size = (GLsizeiptr)lineStride * area.getHeight();
+
+	if (ring.fbo == 0) glGenFramebuffers(1, &ring.fbo);
+	if (slot->pbo == 0) glGenBuffers(1, &slot->pbo);
+
+	GLint previousFBO = 0;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFBO);
+	glBindFramebuffer(GL_FRAMEBUFFER, ring.fbo);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+
+	bool result = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+	if (result)
+	{
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+		if (slot->capacity < slot->size)
+		{
+			glBufferData(GL_PIXEL_PACK_BUFFER, slot->size, nullptr, GL_STREAM_READ);
+			slot->capacity = slot->size;
+		}
+
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(area.getX(), area.getY(), area.getWidth(), area.getHeight(), glFormat, glType, nullptr);
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		slot->callback = callback;
+		slot->result = { nullptr, area.getWidth(), area.getHeight(), lineStride, format };
+		slot->requestTime = Time::getMillisecondCounterHiRes();
+		slot->state = Slot::IN_FLIGHT;
+		inFlightCount++;
+	}
+	else
+	{
+		LOGERROR("GPU Readback : could not read the texture " << (int)texture);
+	}
+
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+	glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
+	glGetError();
+
+	return result;
+}
+
+void GPUReadback::update()
+{
+	Ring& ring = getCurrentRing();
+
+	bool hasMapped = false;
+	for (auto& s : ring.slots)
+	{
+		if (s.state == Slot::DONE)
+		{
+			if (s.mapped)
+			{
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+				glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+			}
+			freeSlot(s);
+			continue;
+		}
+
+		if (s.state != Slot::IN_FLIGHT) continue;
+
+		GLenum status = glClientWaitSync(s.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		if (status == GL_TIMEOUT_EXPIRED) continue;
+
+		glDeleteSync(s.fence);
+		s.fence = nullptr;
+
+		const void* data = nullptr;
+		if (status != GL_WAIT_FAILED)
+		{
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+			data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, s.size, GL_MAP_READ_BIT);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		}
+
+		//failed, still handed to the worker so the callback runs with null data
+		if (data == nullptr) droppedCount++;
+
+		s.result.data = data;
+		s.mapped = data != nullptr;
+		s.state = Slot::MAPPED;
+
+		GenericScopedLock lock(queueLock);
+		mappedSlots.add(&s);
+		hasMapped = true;
+	}
+
+	if (hasMapped) notify();
+}
+
+void GPUReadback::freeSlot(Slot& s)
+{
+	s.callback = nullptr;
+	s.result.data = nullptr;
+	s.mapped = false;
+	s.state = Slot::FREE;
+	inFlightCount--;
+}
+
+void GPUReadback::release()
+{
+	Ring& ring = getCurrentRing();
+
+	//callbacks may still be reading mapped buffers, they are short
+	for (auto& s : ring.slots)
+	{
+		while (s.state == Slot::MAPPED && isThreadRunning()) Thread::sleep(1);
+
+		{
+			GenericScopedLock lock(queueLock);
+			mappedSlots.removeFirstMatchingValue(&s);
+		}
+
+		if ((s.state == Slot::MAPPED || s.state == Slot::DONE) && s.mapped)
+		{
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		}
+
+		//cancelled before its callback ran
+		if ((s.state == Slot::IN_FLIGHT || s.state == Slot::MAPPED) && s.callback)
+		{
+			s.result.data = nullptr;
+			s.callback(s.result);
+		}
+
+		if (s.fence != nullptr) glDeleteSync(s.fence);
+		if (s.pbo != 0) glDeleteBuffers(1, &s.pbo);
+		if (s.state != Slot::FREE) freeSlot(s);
+
+		s.fence = nullptr;
+		s.pbo = 0;
+		s.capacity = 0;
+	}
+
+	if (ring.fbo != 0) glDeleteFramebuffers(1, &ring.fbo);
+	ring.fbo = 0;
+	ring.nextSlot = 0;
+}
+
+void GPUReadback::run()
+{
+	while (!threadShouldExit())
+	{
+		Slot* s = nullptr;
+		{
+			GenericScopedLock lock(queueLock);
+			if (!mappedSlots.isEmpty()) s = mappedSlots.removeAndReturn(0);
+		}
+
+		if (s == nullptr)
+		{
+			wait(100);
+			continue;
+		}
+
+		if (s->callback) s->callback(s->result);
+
+		if (s->result.data != nullptr)
+		{
+			completedBytes += s->size;
+			completedCount++;
+			latencySum = latencySum + (Time::getMillisecondCounterHiRes() - s->requestTime);
+		}
+
+		//unmapped by its GL thread on the next tick
+		s->state = Slot::DONE;
+	}
+}
+
+void GPUReadback::publishStats()
+{
+	const double t = Time::getMillisecondCounterHiRes();
+	const int64 bytes = completedBytes;
+	const int64 count = completedCount;
+	const double latencies = latencySum;
+
+	if (lastPublishTime > 0 && t > lastPublishTime)
+	{
+		bandwidth->setValue((float)((bytes - lastPublishedBytes) / (1024.0 * 1024.0) / ((t - lastPublishTime) / 1000.0)));
+		if (count > lastPublishedCount) latency->setValue((float)((latencies - lastPublishedLatency) / (count - lastPublishedCount)));
+	}
+
+	queueDepth->setValue(inFlightCount.load());
+	droppedRequests->setValue(droppedCount.load());
+
+	lastPublishTime = t;
+	lastPublishedBytes = bytes;
+	lastPublishedCount = count;
+	lastPublishedLatency = latencies;
+}
+
+void GPUReadback::getGLFormat(Format format, GLenum& glFormat, GLenum& glType, int& bytesPerPixel)
+{
+	switch (format)
+	{
+	case BGRA: glFormat = GL_BGRA; glType = GL_UNSIGNED_BYTE; bytesPerPixel = 4; break;
+	case RED: glFormat = GL_RED; glType = GL_UNSIGNED_BYTE; bytesPerPixel = 1; break;
+	case RGBA_FLOAT: glFormat = GL_RGBA; glType = GL_FLOAT; bytesPerPixel = 16; break;
+	case RGBA:
+	default: glFormat = GL_RGBA; glType = GL_UNSIGNED_BYTE; bytesPerPixel = 4; break;
+	}
+}
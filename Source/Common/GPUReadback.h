@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+	GPUReadback.h
+	Created: 18 Oct 2026 7:15:44pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class GlContextHolder;
+
+// Pulls textures back to the CPU without stalling the render loops.
+// A request copies the texture into a pixel pack buffer of a ring owned by the calling GL thread and fences it.
+// Each tick, the GL thread maps the buffers whose fence has signaled and hands them to a worker thread,
+// which runs the callbacks on the mapped memory. The buffers are unmapped and reused on a later tick.
+// A request made while the whole ring of its thread is busy is dropped.
+// Once a request is accepted, its callback runs exactly once : with null data if the buffer could not be mapped,
+// or if the context closed first, so callers can always balance what they count.
+class GPUReadback :
+	public ControllableContainer,
+	public StatsPublisher::Source,
+	public Thread
+{
+public:
+	GPUReadback(GlContextHolder* holder);
+	~GPUReadback();
+
+	static const int numSlots = 8;
+
+	enum Format { RGBA, BGRA, RED, RGBA_FLOAT };
+
+	struct Result
+	{
+		const void* data; //only valid during the callback, nullptr if the readback failed or was cancelled
+		int width;
+		int height;
+		int lineStride;
+		Format format;
+	};
+
+	//called from the worker thread, or from the closing GL thread when cancelled. Rows go from the bottom of the area up, as in GL
+	typedef std::function<void(const Result&)> Callback;
+
+	struct Slot
+	{
+		enum State { FREE, IN_FLIGHT, MAPPED, DONE };
+
+		GLuint pbo = 0;
+		GLsizeiptr capacity = 0;
+		GLsync fence = nullptr;
+		bool mapped = false;
+		std::atomic<int> state { FREE };
+
+		Callback callback;
+		Result result;
+		GLsizeiptr size = 0;
+		double requestTime = 0;
+	};
+
+	//one per GL thread, only touched by that thread and the worker for mapped slots
+	struct Ring
+	{
+		Slot slots[numSlots];
+		GLuint fbo = 0;
+		int nextSlot = 0;
+	};
+
+	GlContextHolder* holder;
+	Ring mainRing;
+	Ring productionRing;
+
+	CriticalSection queueLock;
+	Array<Slot*> mappedSlots;
+
+	IntParameter* queueDepth;
+	FloatParameter* bandwidth;
+	FloatParameter* latency;
+	IntParameter* droppedRequests;
+
+	std::atomic<int> inFlightCount;
+	std::atomic<int64> completedBytes;
+	std::atomic<int64> completedCount;
+	std::atomic<double> latencySum;
+	std::atomic<int> droppedCount;
+	int64 lastPublishedBytes;
+	int64 lastPublishedCount;
+	double lastPublishedLatency;
+	double lastPublishTime;
+
+	//GL threads. Returns false if the request was dropped
+	bool request(GLuint texture, const Rectangle<int>& area, Format format, Callback callback);
+	void update();
+	void release();
+
+	void run() override;
+
+	//message thread
+	void publishStats() override;
+
+	static void getGLFormat(Format format, GLenum& glFormat, GLenum& glType, int& bytesPerPixel);
+
+private:
+	Ring& getCurrentRing();
+	void freeSlot(Slot& s);
+};
@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+	HeadlessGLContext.cpp
+	Created: 16 Oct 2026 6:02:37pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+#if JUCE_LINUX
+//keep X11 macros (None, Bool, Status...) out of the unity build
+#define EGL_NO_X11 1
+#define MESA_EGL_NO_X11_HEADERS 1
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+#endif
+
+HeadlessGLContext::HeadlessGLContext(juce::OpenGLRenderer* renderer) :
+	Thread("Headless GL"),
+	renderer(renderer),
+	targetFPS(60),
+	display(nullptr),
+	context(nullptr),
+	surface(nullptr)
+{
+}
+
+HeadlessGLContext::~HeadlessGLContext()
+{
+	stopThread(5000);
+}
+
+void HeadlessGLContext::execute(std::function<void()> job, bool shouldBlock)
+{
+	if (getCurrentThreadId() == getThreadId())
+	{
+		job();
+		return;
+	}
+
+	//same as an OpenGLContext that is not attached, nothing to run the job on
+	if (!isThreadRunning()) return;
+
+	std::shared_ptr<WaitableEvent> done = std::make_shared<WaitableEvent>();
+	{
+		GenericScopedLock lock(jobsLock);
+		jobs.add([job, done]() { job(); done->signal(); });
+	}
+
+	if (!shouldBlock) return;
+	while (!done->wait(50)) if (!isThreadRunning()) break;
+}
+
+bool HeadlessGLContext::createContext()
+{
+#if JUCE_LINUX
+	EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+
+	//prefer the surfaceless platform so no X or Wayland server is needed at all
+	String clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+	if (clientExtensions.contains("EGL_MESA_platform_surfaceless"))
+	{
+		if (PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT"))
+			eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+	}
+
+	if (eglDisplay == EGL_NO_DISPLAY) eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+	EGLint major = 0, minor = 0;
+	if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, &major, &minor))
+	{
+		LOGERROR("Headless : could not initialize EGL display");
+		return false;
+	}
+
+	display = eglDisplay;
+
+	if (!eglBindAPI(EGL_OPENGL_API))
+	{
+		LOGERROR("Headless : EGL display does not support desktop OpenGL");
+		return false;
+	}
+
+	const EGLint configAttribs[] = {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8,
+		EGL_GREEN_SIZE, 8,
+		EGL_BLUE_SIZE, 8,
+		EGL_ALPHA_SIZE, 8,
+		EGL_DEPTH_SIZE, 24,
+		EGL_NONE
+	};
+
+	EGLConfig config = nullptr;
+	EGLint numConfigs = 0;
+	if (!eglChooseConfig(eglDisplay, configAttribs, &config, 1, &numConfigs) || numConfigs == 0)
+	{
+		LOGERROR("Headless : no suitable EGL config found");
+		return false;
+	}
+
+	//default attributes give a compatibility profile, same as the windowed context
+	EGLContext eglContext = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, nullptr);
+	if (eglContext == EGL_NO_CONTEXT)
+	{
+		LOGERROR("Headless : could not create EGL context");
+		return false;
+	}
+
+	context = eglContext;
+
+	//everything renders to framebuffers, the pbuffer is only there when surfaceless contexts are not supported
+	EGLSurface eglSurface = EGL_NO_SURFACE;
+	String displayExtensions = eglQueryString(eglDisplay, EGL_EXTENSIONS);
+	if (!displayExtensions.contains("EGL_KHR_surfaceless_context"))
+	{
+		const EGLint pbufferAttribs[] = { EGL_WIDTH, 16, EGL_HEIGHT, 16, EGL_NONE };
+		eglSurface = eglCreatePbufferSurface(eglDisplay, config, pbufferAttribs);
+		if (eglSurface == EGL_NO_SURFACE)
+		{
+			LOGERROR("Headless : could not create EGL pbuffer");
+			return false;
+		}
+
+		surface = eglSurface;
+	}
+
+	if (!eglMakeCurrent(eglDisplay, eglSurface, eglSurface, eglContext))
+	{
+		LOGERROR("Headless : could not make EGL context current");
+		return false;
+	}
+
+	juce::gl::loadFunctions();
+
+	LOG("Headless : EGL " << (int)major << "." << (int)minor << ", " << String((const char*)juce::gl::glGetString(juce::gl::GL_RENDERER)) << (eglSurface == EGL_NO_SURFACE ? " (surfaceless)" : " (pbuffer)"));
+	return true;
+#else
+	LOGERROR("Headless rendering is only supported on Linux (EGL)");
+	return false;
+#endif
+}
+
+void HeadlessGLContext::destroyContext()
+{
+#if JUCE_LINUX
+	if (display == nullptr) return;
+
+	eglMakeCurrent((EGLDisplay)display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	if (surface != nullptr) eglDestroySurface((EGLDisplay)display, (EGLSurface)surface);
+	if (context != nullptr) eglDestroyContext((EGLDisplay)display, (EGLContext)context);
+	eglTerminate((EGLDisplay)display);
+#endif
+
+	display = nullptr;
+	context = nullptr;
+	surface = nullptr;
+}
+
+void HeadlessGLContext::processJobs()
+{
+	Array<std::function<void()>> jobsToRun;
+	{
+		GenericScopedLock lock(jobsLock);
+		jobsToRun.swapWith(jobs);
+	}
+
+	for (auto& j : jobsToRun) j();
+}
+
+void HeadlessGLContext::run()
+{
+	if (!createContext())
+	{
+		destroyContext();
+		return;
+	}
+
+	renderer->newOpenGLContextCreated();
+
+	double nextFrameTime = Time::getMillisecondCounterHiRes();
+
+	while (!threadShouldExit())
+	{
+		processJobs();
+		renderer->renderOpenGL();
+		juce::gl::glFlush();
+
+		//no vsync to pace the loop, tick at the target rate on an accumulating clock
+		int fps = targetFPS;
+		if (fps <= 0) continue;
+
+		const double t = Time::getMillisecondCounterHiRes();
+		nextFrameTime = jmax(nextFrameTime + 1000.0 / fps, t - 1000.0 / fps);
+		if (nextFrameTime > t) wait((int)(nextFrameTime - t));
+	}
+
+	processJobs();
+	renderer->openGLContextClosing();
+	destroyContext();
+}
@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+	HeadlessGLContext.h
+	Created: 16 Oct 2026 6:02:37pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Offscreen GL context (EGL surfaceless or pbuffer) with its own render thread,
+// used instead of an attached juce::OpenGLContext when running without any window.
+class HeadlessGLContext :
+	public Thread
+{
+public:
+	HeadlessGLContext(juce::OpenGLRenderer* renderer);
+	~HeadlessGLContext();
+
+	juce::OpenGLRenderer* renderer;
+	std::atomic<int> targetFPS; //0 to render as fast as possible
+
+	void* display;
+	void* context;
+	void* surface;
+
+	CriticalSection jobsLock;
+	Array<std::function<void()>> jobs;
+
+	void execute(std::function<void()> job, bool shouldBlock);
+
+	bool createContext();
+	void destroyContext();
+	void processJobs();
+
+	void run() override;
+};
@@ -17,6 +17,21 @@ bool MediaTarget::isUsingMedia(Media* m)
 	return false;
 }
 
+juce::OpenGLRenderer* MediaTarget::getRenderConsumer()
+{
+	ControllableContainer* cc = dynamic_cast<ControllableContainer*>(this);
+	if (cc == nullptr) return nullptr;
+
+	cc = cc->parentContainer.get();
+	while (cc != nullptr)
+	{
+		if (juce::OpenGLRenderer* r = dynamic_cast<juce::OpenGLRenderer*>(cc)) return r;
+		cc = cc->parentContainer.get();
+	}
+
+	return nullptr;
+}
+
 void MediaTarget::registerUseMedia(int id, Media* m)
 {
 	if (usedMedias.contains(id))
@@ -35,3 +50,8 @@ void MediaTarget::unregisterUseMedia(int id)
 	usedMedias[id]->unregisterTarget(this);
 	usedMedias.remove(id);
 }
+
+void MediaTarget::notifyMediaUsageChanged()
+{
+	if (GlContextHolder::getInstanceWithoutCreating() != nullptr) GlContextHolder::getInstance()->renderGraph.setDirty();
+}
@@ -22,6 +22,12 @@ public:
 
 	virtual bool isUsingMedia(Media* m);
 
+	//the renderer that samples the medias used by this target, used to order rendering
+	virtual juce::OpenGLRenderer* getRenderConsumer();
+
 	void registerUseMedia(int id, Media* m);
 	void unregisterUseMedia(int id);
+
+	//call when the result of isUsingMedia may have changed (enabled, active...)
+	void notifyMediaUsageChanged();
 };
\ No newline at end of file
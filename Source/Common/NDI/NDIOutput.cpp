@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+	NDIOutput.cpp
+	Created: 18 Oct 2026 4:21:52pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+NDIOutput::NDIOutput(const String& name) :
+	Thread("NDI Output " + name),
+	name(name),
+	sendInstance(nullptr),
+	sentIndex(-1),
+	sendingIndex(-1),
+	pendingIndex(-1),
+	droppedFrames(0)
+{
+	NDIlib_send_create_t desc;
+	desc.p_ndi_name = this->name.toRawUTF8();
+	desc.clock_video = false; //frames are paced by the renderer
+
+	sendInstance = NDIlib_send_create(&desc);
+	if (sendInstance == nullptr)
+	{
+		LOGERROR("NDI Output : could not create the NDI source " << name);
+		return;
+	}
+
+	NLOG("NDI", "Output created : " << name);
+	startThread();
+}
+
+NDIOutput::~NDIOutput()
+{
+	signalThreadShouldExit();
+	notify();
+	stopThread(1000);
+
+	if (sendInstance != nullptr)
+	{
+		//waits for NDI to be done with the last buffer
+		NDIlib_send_send_video_async_v2(sendInstance, nullptr);
+		NDIlib_send_destroy(sendInstance);
+	}
+}
+
+bool NDIOutput::pushFrame(const void* uyvyData, int width, int height, int fps)
+{
+	if (sendInstance == nullptr) return false;
+
+	int index = -1;
+	{
+		GenericScopedLock lock(indexLock);
+		for (int i = 0; i < numBuffers && index < 0; i++)
+		{
+			if (i != sentIndex && i != sendingIndex && i != pendingIndex) index = i;
+		}
+	}
+
+	if (index < 0)
+	{
+		droppedFrames++;
+		return false;
+	}
+
+	//the thread never touches a free buffer, the copy can happen outside of the lock
+	Frame& f = frames[index];
+	const size_t size = (size_t)width * height * 2;
+	if (f.data.getSize() != size) f.data.setSize(size);
+	f.data.copyFrom(uyvyData, 0, size);
+	f.width = width;
+	f.height = height;
+	f.fps = fps;
+
+	{
+		GenericScopedLock lock(indexLock);
+		if (pendingIndex >= 0) droppedFrames++;
+		pendingIndex = index;
+	}
+
+	notify();
+	return true;
+}
+
+void NDIOutput::run()
+{
+	while (!threadShouldExit())
+	{
+		int index = -1;
+		{
+			GenericScopedLock lock(indexLock);
+			index = pendingIndex;
+			pendingIndex = -1;
+			if (index >= 0) sendingIndex = index;
+		}
+
+		if (index < 0)
+		{
+			wait(100);
+			continue;
+		}
+
+		Frame& f = frames[index];
+
+		NDIlib_video_frame_v2_t frame;
+		frame.xres = f.width;
+		frame.yres = f.height;
+		frame.FourCC = NDIlib_FourCC_type_UYVY;
+		frame.frame_rate_N = f.fps > 0 ? f.fps * 1000 : 60000;
+		frame.frame_rate_D = 1000;
+		frame.picture_aspect_ratio = (float)f.width / f.height;
+		frame.frame_format_type = NDIlib_frame_format_type_progressive;
+		frame.timecode = NDIlib_send_timecode_synthesize;
+		frame.p_data = (uint8_t*)f.data.getData();
+		frame.line_stride_in_bytes = f.width * 2;
+
+		//returns once NDI is done with the previous buffer
+		NDIlib_send_send_video_async_v2(sendInstance, &frame);
+
+		GenericScopedLock lock(indexLock);
+		sentIndex = index;
+		sendingIndex = -1;
+	}
+}
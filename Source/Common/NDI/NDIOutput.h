@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+	NDIOutput.h
+	Created: 18 Oct 2026 4:21:52pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// NDI source sending UYVY video frames from its own thread.
+// The GL thread copies each frame in a free buffer of a small ring and returns, the thread sends it asynchronously.
+// NDI keeps reading the buffer of an async send until the next send returns, so at any time one buffer is being sent,
+// one is handed to NDI, one is waiting and one is being filled. A waiting frame replaced by a newer one is dropped.
+class NDIOutput :
+	public Thread
+{
+public:
+	NDIOutput(const String& name);
+	~NDIOutput();
+
+	static const int numBuffers = 4;
+
+	struct Frame
+	{
+		MemoryBlock data;
+		int width = 0;
+		int height = 0;
+		int fps = 0;
+	};
+
+	String name;
+	NDIlib_send_instance_t sendInstance;
+
+	Frame frames[numBuffers];
+	SpinLock indexLock;
+	int sentIndex; //still read by NDI until the next send returns
+	int sendingIndex; //passed to the send in progress
+	int pendingIndex; //waiting for the thread
+	std::atomic<int> droppedFrames;
+
+	//producer thread, width has to be even. Returns false if the frame could not be queued
+	bool pushFrame(const void* uyvyData, int width, int height, int fps);
+
+	void run() override;
+};
@@ -14,7 +14,14 @@
 juce_ImplementSingleton(GlContextHolder)
 
 GlContextHolder::GlContextHolder() :
-	timeAtRender(0)
+	timeAtRender(0),
+	frameBufferPool(context, frameScheduler),
+	quadBatcher(context),
+	readback(this),
+	offlineRenderers(0),
+	parent(nullptr),
+	useProductionThread(false),
+	whiteTexture(0)
 {
 }
 
@@ -26,6 +33,7 @@ GlContextHolder::~GlContextHolder()
 void GlContextHolder::setup(juce::Component* topLevelComponent)
 {
 	parent = topLevelComponent;
+	useProductionThread = true;
 	if(OpenGLRenderer* r = dynamic_cast<OpenGLRenderer*>(parent)) registerOpenGlRenderer(r);
 
 	context.setSwapInterval(0);
@@ -35,6 +43,15 @@ void GlContextHolder::setup(juce::Component* topLevelComponent)
 	context.attachTo(*parent);
 }
 
+void GlContextHolder::setupHeadless()
+{
+	jassert(parent == nullptr && headlessContext == nullptr);
+
+	//single offscreen context, medias are rendered on the same thread as the screens
+	headlessContext.reset(new HeadlessGLContext(this));
+	headlessContext->startThread();
+}
+
 //==============================================================================
 // The context holder MUST explicitely call detach in their destructor
 
@@ -47,6 +64,19 @@ void GlContextHolder::detach()
 		if (juce::Component* comp = clients[i]->c)
 			comp->removeComponentListener(this);
 
+	if (headlessContext != nullptr)
+	{
+		headlessContext.reset();
+		return;
+	}
+
+	//shares the main context, has to go first. Detached before reset so its closing callback still finds it
+	if (production != nullptr)
+	{
+		production->context.detach();
+		production.reset();
+	}
+
 	context.detach();
 	context.setRenderer(nullptr);
 }
@@ -64,9 +94,10 @@ void GlContextHolder::registerOpenGlRenderer(juce::OpenGLRenderer* child)
 		{
 			juce::Component* c = dynamic_cast<juce::Component*> (child);
 			Client::State state = Client::State::running;
-			if (c != nullptr) state = (parent == c || parent->isParentOf(c)) ? Client::State::running : Client::State::suspended;
+			if (c != nullptr) state = (parent != nullptr && (parent == c || parent->isParentOf(c))) ? Client::State::running : Client::State::suspended;
 			clients.add(new Client(child, state));
 			if(c != nullptr) c->addComponentListener(this);
+			renderGraph.setDirty();
 		}
 	}
 	else
@@ -88,13 +119,18 @@ void GlContextHolder::unregisterOpenGlRenderer(juce::OpenGLRenderer* child)
 		}
 
 		if(client->c!= nullptr) client->c->removeComponentListener(this);
-		context.executeOnGLThread([this](juce::OpenGLContext&)
+		executeOnGLThread([this]()
 			{
 				checkComponents(false, false);
 			}, true);
+		if (production != nullptr) executeOnProductionThread([this]()
+			{
+				checkComponents(false, false, true);
+			}, true);
 		client->c = nullptr;
 
 		clients.remove(index);
+		renderGraph.setDirty();
 	}
 }
 
@@ -103,10 +139,53 @@ void GlContextHolder::setBackgroundColour(const juce::Colour c)
 	backgroundColour = c;
 }
 
+void GlContextHolder::executeOnGLThread(std::function<void()> job, bool shouldBlock)
+{
+	if (headlessContext != nullptr) headlessContext->execute(job, shouldBlock);
+	else context.executeOnGLThread([job](juce::OpenGLContext&) { job(); }, shouldBlock);
+}
+
+void GlContextHolder::executeOnProductionThread(std::function<void()> job, bool shouldBlock)
+{
+	if (production != nullptr) production->context.executeOnGLThread([job](juce::OpenGLContext&) { job(); }, shouldBlock);
+	else executeOnGLThread(job, shouldBlock);
+}
+
+bool GlContextHolder::isProductionThread() const
+{
+	return production != nullptr && juce::OpenGLContext::getCurrentContext() == &production->context;
+}
+
+juce::OpenGLContext& GlContextHolder::getCurrentContext()
+{
+	return isProductionThread() ? production->context : context;
+}
+
+FrameScheduler& GlContextHolder::getFrameScheduler()
+{
+	return isProductionThread() ? production->frameScheduler : frameScheduler;
+}
+
+FrameBufferPool& GlContextHolder::getFrameBufferPool()
+{
+	return isProductionThread() ? production->frameBufferPool : frameBufferPool;
+}
+
+QuadBatcher& GlContextHolder::getQuadBatcher()
+{
+	return isProductionThread() ? production->quadBatcher : quadBatcher;
+}
+
+GLuint GlContextHolder::getWhiteTextureID()
+{
+	return whiteTexture;
+}
+
 //==============================================================================
 
-void GlContextHolder::checkComponents(bool isClosing, bool isDrawing)
+void GlContextHolder::checkComponents(bool isClosing, bool isDrawing, bool isProduction)
 {
+	Lane& lane = isProduction ? productionLane : mainLane;
 	juce::Array<Client*> initClients, runningClients;
 
 	{
@@ -118,6 +197,8 @@ void GlContextHolder::checkComponents(bool isClosing, bool isDrawing)
 		for (int i = 0; i < n; ++i)
 		{
 			Client* client = clients[i];
+			if (isProductionClient(client) != isProduction) continue;
+
 			if (client->r != nullptr)
 			{
 				Client::State nextState = (isClosing ? Client::State::suspended : client->nextState);
@@ -139,15 +220,18 @@ void GlContextHolder::checkComponents(bool isClosing, bool isDrawing)
 
 	if (runningClients.size() > 0 && isDrawing)
 	{
-		const float displayScale = static_cast<float> (context.getRenderingScale());
-		const juce::Rectangle<int> parentBounds = (parent->getLocalBounds().toFloat() * displayScale).getSmallestIntegerContainer();
+		updateRenderOrder(lane, runningClients, isProduction);
+
+		//no components to lay out when headless
+		const float displayScale = parent != nullptr ? static_cast<float> (context.getRenderingScale()) : 1.0f;
+		const juce::Rectangle<int> parentBounds = parent != nullptr ? (parent->getLocalBounds().toFloat() * displayScale).getSmallestIntegerContainer() : juce::Rectangle<int>();
 
-		for (int i = 0; i < runningClients.size(); ++i)
+		for (int i = 0; i < lane.renderOrder.size(); ++i)
 		{
-			Client* rc = runningClients.getReference(i);
+			Client* rc = lane.renderOrder.getReference(i);
 			juce::Component* comp = rc->c;
 
-			if (comp != nullptr)
+			if (comp != nullptr && parent != nullptr)
 			{
 				juce::Rectangle<int> r = (parent->getLocalArea(comp, comp->getLocalBounds()).toFloat() * displayScale).getSmallestIntegerContainer();
 				glViewport((GLint)r.getX(),
@@ -161,6 +245,48 @@ void GlContextHolder::checkComponents(bool isClosing, bool isDrawing)
 	}
 }
 
+void GlContextHolder::updateRenderOrder(Lane& lane, const juce::Array<Client*>& runningClients, bool isProduction)
+{
+	if (useProductionThread && !isProduction)
+	{
+		//no producers left on this thread, renderers first then components, in registration order
+		if (runningClients == lane.lastRunningClients) return;
+		lane.lastRunningClients = runningClients;
+
+		//which medias are live depends on the screens and views running here
+		renderGraph.setDirty();
+
+		lane.renderOrder.clear();
+		for (auto& rc : runningClients) if (rc->c == nullptr) lane.renderOrder.add(rc);
+		for (auto& rc : runningClients) if (rc->c != nullptr) lane.renderOrder.add(rc);
+		return;
+	}
+
+	if (!renderGraph.isDirty.exchange(false) && runningClients == lane.lastRunningClients) return;
+
+	lane.lastRunningClients = runningClients;
+
+	//the production thread needs the running clients of the main thread as roots to know which medias are pulled
+	juce::Array<Client*> graphClients(runningClients);
+	if (isProduction)
+	{
+		juce::ScopedLock arrayLock(clients.getLock());
+		for (auto& c : clients) if (!isProductionClient(c) && c->currentState == Client::State::running) graphClients.add(c);
+	}
+
+	juce::Array<juce::OpenGLRenderer*> renderers;
+	juce::Array<bool> isPresentation;
+	for (auto& rc : graphClients)
+	{
+		renderers.add(rc->r);
+		isPresentation.add(rc->c != nullptr);
+	}
+
+	lane.renderOrder.clear();
+	juce::Array<int> order = renderGraph.computeRenderOrder(renderers, isPresentation);
+	for (auto& i : order) if (i < runningClients.size()) lane.renderOrder.add(graphClients[i]);
+}
+
 //==============================================================================
 
 void GlContextHolder::componentParentHierarchyChanged(juce::Component& component)
@@ -196,14 +322,19 @@ void GlContextHolder::componentBeingDeleted(juce::Component& component)
 		client->nextState = Client::State::suspended;
 
 		component.removeComponentListener(this);
-		context.executeOnGLThread([this](juce::OpenGLContext&)
+		executeOnGLThread([this]()
 			{
 				checkComponents(false, false);
 			}, true);
+		if (production != nullptr) executeOnProductionThread([this]()
+			{
+				checkComponents(false, false, true);
+			}, true);
 
 		client->c = nullptr;
 
 		clients.remove(index);
+		renderGraph.setDirty();
 	}
 }
 
@@ -215,18 +346,84 @@ void GlContextHolder::newOpenGLContextCreated()
 	gl::glDebugMessageControl(gl::GL_DEBUG_SOURCE_API, gl::GL_DEBUG_TYPE_OTHER, gl::GL_DEBUG_SEVERITY_NOTIFICATION, 0, 0, gl::GL_FALSE);
 	glDisable(GL_DEBUG_OUTPUT);
 #endif
+	//raw GL, juce::OpenGLTexture needs a juce::OpenGLContext current, there is none on the headless thread
+	const GLubyte white[4] = { 255, 255, 255, 255 };
+	glGenTextures(1, &whiteTexture);
+	glBindTexture(GL_TEXTURE_2D, whiteTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
 	checkComponents(false, false);
+
+	//the production context can only share with the main one once it exists
+	if (useProductionThread && production == nullptr)
+	{
+		juce::MessageManager::callAsync([]()
+			{
+				if (GlContextHolder* holder = GlContextHolder::getInstanceWithoutCreating()) holder->startProduction();
+			});
+	}
 }
 
 void GlContextHolder::renderOpenGL()
 {
 	timeAtRender = Time::getMillisecondCounterHiRes();
 
-	juce::OpenGLHelpers::clear(backgroundColour);
+	IntParameter* fpsLimit = RMPSettings::getInstance()->fpsLimit;
+	frameScheduler.tick(timeAtRender, fpsLimit->enabled && offlineRenderers == 0 ? fpsLimit->intValue() : 0);
+	if (headlessContext != nullptr) headlessContext->targetFPS = frameScheduler.globalFPS;
+
+	if (parent != nullptr) juce::OpenGLHelpers::clear(backgroundColour);
 	checkComponents(false, true);
+	FrameHandoff::readerFrameDone();
+
+	readback.update();
+	frameBufferPool.trim(frameScheduler.numTicks);
 }
 
 void GlContextHolder::openGLContextClosing()
 {
 	checkComponents(true, false);
+	FrameHandoff::readerFrameDone();
+	readback.release();
+	frameBufferPool.clear();
+	quadBatcher.release();
+	if (whiteTexture != 0) glDeleteTextures(1, &whiteTexture);
+	whiteTexture = 0;
+}
+
+//==============================================================================
+
+void GlContextHolder::startProduction()
+{
+	if (production != nullptr || parent == nullptr) return;
+	production.reset(new GLProductionContext(this, parent, context));
+}
+
+void GlContextHolder::productionContextCreated()
+{
+	checkComponents(false, false, true);
+}
+
+void GlContextHolder::renderProduction()
+{
+	IntParameter* fpsLimit = RMPSettings::getInstance()->fpsLimit;
+	production->frameScheduler.tick(Time::getMillisecondCounterHiRes(), fpsLimit->enabled && offlineRenderers == 0 ? fpsLimit->intValue() : 0);
+
+	checkComponents(false, true, true);
+	FrameHandoff::readerFrameDone();
+
+	readback.update();
+	production->frameBufferPool.trim(production->frameScheduler.numTicks);
+}
+
+void GlContextHolder::productionContextClosing()
+{
+	checkComponents(true, false, true);
+	FrameHandoff::readerFrameDone();
+	readback.release();
+	production->frameBufferPool.clear();
+	production->quadBatcher.release();
 }
@@ -25,6 +25,14 @@ public:
 
 	void setup(juce::Component* topLevelComponent);
 
+	//renders without any window, from an offscreen context and its own thread
+	void setupHeadless();
+	bool isHeadless() const { return headlessContext != nullptr; }
+
+	//medias are rendered by a second shared context when there is a window, see GLProductionContext
+	bool hasProductionThread() const { return production != nullptr; }
+	bool isProductionThread() const;
+
 	//==============================================================================
 	// The context holder MUST explicitely call detach in their destructor
 	void detach();
@@ -38,10 +46,37 @@ public:
 	void setBackgroundColour(const juce::Colour c);
 
 	juce::OpenGLContext context;
+	std::unique_ptr<HeadlessGLContext> headlessContext;
+	RenderGraph renderGraph;
+	FrameScheduler frameScheduler;
+	FrameBufferPool frameBufferPool;
+	QuadBatcher quadBatcher;
+	GPUReadback readback; //textures to the CPU from any of the GL threads, see GPUReadback
+	std::atomic<int> offlineRenderers; //while above 0 the render loops ignore the fps limit, see ScreenRecorder
+	std::unique_ptr<GLProductionContext> production;
+
+	void executeOnGLThread(std::function<void()> job, bool shouldBlock);
+	//falls back to the main GL thread when there is no production thread
+	void executeOnProductionThread(std::function<void()> job, bool shouldBlock);
+
+	//resources of the context current on the calling GL thread
+	juce::OpenGLContext& getCurrentContext();
+	FrameScheduler& getFrameScheduler();
+	FrameBufferPool& getFrameBufferPool();
+	QuadBatcher& getQuadBatcher();
+
+	//1x1 white texture, the neutral mask of the main context (headless included), created with it
+	GLuint getWhiteTextureID();
+
+	//called by the GLProductionContext from its thread
+	void productionContextCreated();
+	void renderProduction();
+	void productionContextClosing();
 
 private:
 	//==============================================================================
-	void checkComponents(bool isClosing, bool isDrawing);
+	void checkComponents(bool isClosing, bool isDrawing, bool isProduction = false);
+	void startProduction();
 
 	//==============================================================================
 	void componentParentHierarchyChanged(juce::Component& component) override;
@@ -59,8 +94,8 @@ private:
 
 	//==============================================================================
 	juce::Component* parent;
-
-	
+	bool useProductionThread;
+	GLuint whiteTexture;
 
 	struct Client
 	{
@@ -71,18 +106,32 @@ private:
 		};
 
 		Client(juce::OpenGLRenderer* r, State nextStateToUse = State::suspended)
-			: r(r), c(dynamic_cast<Component*>(r)), currentState(State::suspended), nextState(nextStateToUse) {}
+			: r(r), c(dynamic_cast<Component*>(r)), isNode(dynamic_cast<RenderGraphNode*>(r) != nullptr), currentState(State::suspended), nextState(nextStateToUse) {}
 
 
 		juce::OpenGLRenderer* r = nullptr;
 		juce::Component* c = nullptr;
+		bool isNode = false;
 		State currentState = State::suspended, nextState = State::suspended;
 	};
 
+	//clients rendered by one GL thread, only accessed from that thread
+	struct Lane
+	{
+		juce::Array<Client*> lastRunningClients;
+		juce::Array<Client*> renderOrder;
+	};
+
 
 	juce::CriticalSection stateChangeCriticalSection;
 	juce::OwnedArray<Client, juce::CriticalSection> clients;
 
+	Lane mainLane;
+	Lane productionLane;
+
+	bool isProductionClient(const Client* client) const { return useProductionThread && client->c == nullptr && client->isNode; }
+	void updateRenderOrder(Lane& lane, const juce::Array<Client*>& runningClients, bool isProduction);
+
 	//==============================================================================
 	int findClientIndexForComponent(juce::Component* c) const
 	{
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+	PresentTimer.cpp
+	Created: 18 Oct 2026 11:34:08am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+PresentTimer::PresentTimer(const String& name) :
+	ControllableContainer(name),
+	lastPresentTime(0),
+	lastPublishTime(0),
+	lastFrameNumber(-1),
+	repeatedCount(0),
+	skippedCount(0),
+	skewedCount(0),
+	intervalHistoryIndex(0),
+	latencyHistoryIndex(0),
+	publishedIntervalAvg(0),
+	publishedIntervalJitter(0),
+	publishedLatencyAvg(0),
+	publishedLatencyP99(0),
+	publishedRepeated(0),
+	publishedSkipped(0),
+	publishedSkewed(0)
+{
+	intervalAvg = addFloatParameter("Present Interval", "Average time between two presented frames, in milliseconds", 0, 0);
+	intervalJitter = addFloatParameter("Present Jitter", "Standard deviation of the time between two presented frames, in milliseconds", 0, 0);
+	latencyAvg = addFloatParameter("Latency Avg", "Average time from a frame being rendered to it being presented, in milliseconds", 0, 0);
+	latencyP99 = addFloatParameter("Latency P99", "99th percentile of the time from a frame being rendered to it being presented, in milliseconds", 0, 0);
+	repeatedFrames = addIntParameter("Repeated Frames", "Number of presents showing the same frame as the previous one, since the output opened", 0, 0);
+	skippedFrames = addIntParameter("Skipped Frames", "Number of rendered frames that were never presented, since the output opened", 0, 0);
+	skewedFrames = addIntParameter("Skewed Frames", "Number of presents where the frame locked outputs did not show the same frame or one of them was late, since the output opened", 0, 0);
+
+	for (auto& c : controllables)
+	{
+		c->isSavable = false;
+		c->enabled = false;
+	}
+
+	StatsPublisher::getInstance()->addSource(this);
+}
+
+PresentTimer::~PresentTimer()
+{
+	if (StatsPublisher::getInstanceWithoutCreating() != nullptr) StatsPublisher::getInstance()->removeSource(this);
+}
+
+void PresentTimer::presented(double time, int64 frameNumber, double frameTime)
+{
+	if (lastPresentTime > 0) RenderTimer::addSample(intervalHistory, intervalHistoryIndex, (float)(time - lastPresentTime));
+	lastPresentTime = time;
+
+	if (frameNumber >= 0)
+	{
+		RenderTimer::addSample(latencyHistory, latencyHistoryIndex, (float)(time - frameTime));
+
+		if (lastFrameNumber >= 0)
+		{
+			if (frameNumber == lastFrameNumber) repeatedCount++;
+			else if (frameNumber > lastFrameNumber + 1) skippedCount += (int)(frameNumber - lastFrameNumber - 1);
+		}
+		lastFrameNumber = frameNumber;
+	}
+
+	if (time > lastPublishTime + 500)
+	{
+		lastPublishTime = time;
+		publish();
+	}
+}
+
+void PresentTimer::addSkew(int64 spread)
+{
+	if (spread != 0) skewedCount++;
+}
+
+void PresentTimer::reset()
+{
+	lastPresentTime = 0;
+	lastFrameNumber = -1;
+	repeatedCount = 0;
+	skippedCount = 0;
+	skewedCount = 0;
+	intervalHistory.clearQuick();
+	latencyHistory.clearQuick();
+	intervalHistoryIndex = 0;
+	latencyHistoryIndex = 0;
+}
+
+void PresentTimer::publish()
+{
+	float iAvg = 0, iP99 = 0, lAvg = 0, lP99 = 0;
+	RenderTimer::getStats(intervalHistory, iAvg, iP99);
+	RenderTimer::getStats(latencyHistory, lAvg, lP99);
+
+	float variance = 0;
+	for (auto& v : intervalHistory) variance += (v - iAvg) * (v - iAvg);
+	if (!intervalHistory.isEmpty()) variance /= intervalHistory.size();
+
+	publishedIntervalAvg = iAvg;
+	publishedIntervalJitter = std::sqrt(variance);
+	publishedLatencyAvg = lAvg;
+	publishedLatencyP99 = lP99;
+	publishedRepeated = repeatedCount;
+	publishedSkipped = skippedCount;
+	publishedSkewed = skewedCount;
+}
+
+void PresentTimer::publishStats()
+{
+	intervalAvg->setValue(publishedIntervalAvg.load());
+	intervalJitter->setValue(publishedIntervalJitter.load());
+	latencyAvg->setValue(publishedLatencyAvg.load());
+	latencyP99->setValue(publishedLatencyP99.load());
+	repeatedFrames->setValue(publishedRepeated.load());
+	skippedFrames->setValue(publishedSkipped.load());
+	skewedFrames->setValue(publishedSkewed.load());
+}
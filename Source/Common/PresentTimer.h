@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+	PresentTimer.h
+	Created: 18 Oct 2026 11:34:08am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Presentation metrics of an output window, gathered on its GL thread.
+// The interval between two presented frames and its jitter show how steadily the output follows the display,
+// the latency is the time from the frame being completed by the renderer to it being presented.
+// Repeated and skipped frames count renderer frames shown twice or never shown,
+// skewed frames the presents where outputs kept in lockstep did not show the same frame.
+class PresentTimer :
+	public ControllableContainer,
+	public StatsPublisher::Source
+{
+public:
+	PresentTimer(const String& name = "Present Stats");
+	~PresentTimer();
+
+	FloatParameter* intervalAvg;
+	FloatParameter* intervalJitter;
+	FloatParameter* latencyAvg;
+	FloatParameter* latencyP99;
+	IntParameter* repeatedFrames;
+	IntParameter* skippedFrames;
+	IntParameter* skewedFrames;
+
+	//GL thread
+	double lastPresentTime;
+	double lastPublishTime;
+	int64 lastFrameNumber;
+	int repeatedCount;
+	int skippedCount;
+	int skewedCount;
+
+	Array<float> intervalHistory;
+	Array<float> latencyHistory;
+	int intervalHistoryIndex;
+	int latencyHistoryIndex;
+
+	//written by the GL thread, read by the message thread
+	std::atomic<float> publishedIntervalAvg;
+	std::atomic<float> publishedIntervalJitter;
+	std::atomic<float> publishedLatencyAvg;
+	std::atomic<float> publishedLatencyP99;
+	std::atomic<int> publishedRepeated;
+	std::atomic<int> publishedSkipped;
+	std::atomic<int> publishedSkewed;
+
+	void presented(double time, int64 frameNumber, double frameTime);
+	void addSkew(int64 spread);
+	void reset();
+	void publish();
+
+	//message thread
+	void publishStats() override;
+};
@@ -0,0 +1,274 @@
+/*
+  ==============================================================================
+
+	QuadBatcher.cpp
+	Created: 16 Oct 2026 11:12:08pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+using namespace juce::gl;
+
+QuadBatcher::QuadBatcher(OpenGLContext& context) :
+	context(context),
+	vao(0),
+	vbo(0),
+	ebo(0),
+	projectionLocation(-1),
+	useTextureLocation(-1),
+	bufferOffset(0),
+	currentTexture(0),
+	blendSrc(GL_SRC_ALPHA),
+	blendDst(GL_ONE_MINUS_SRC_ALPHA),
+	isDrawing(false),
+	projection{ 1, 1, 0, 0 }
+{
+	vertices.ensureStorageAllocated(maxQuads * 4);
+}
+
+QuadBatcher::~QuadBatcher()
+{
+	//GL objects must have been released from the GL thread before
+	jassert(vao == 0);
+}
+
+bool QuadBatcher::init()
+{
+	release();
+
+	//same shader for solid and textured quads, a solid quad is a textured one with texture 0
+	const String vertexShader = R"(
+		attribute vec2 position;
+		attribute vec2 texCoord;
+		attribute vec4 color;
+
+		uniform vec4 projection;
+
+		varying vec2 fragTexCoord;
+		varying vec4 fragColor;
+
+		void main()
+		{
+			fragTexCoord = texCoord;
+			fragColor = color;
+			gl_Position = vec4(position * projection.xy + projection.zw, 0.0, 1.0);
+		}
+	)";
+
+	const String fragmentShader = R"(
+		varying vec2 fragTexCoord;
+		varying vec4 fragColor;
+
+		uniform sampler2D tex;
+		uniform float useTexture;
+
+		void main()
+		{
+			gl_FragColor = mix(vec4(1.0), texture2D(tex, fragTexCoord), useTexture) * fragColor;
+		}
+	)";
+
+	textureShader.reset(new OpenGLShaderProgram(context));
+	if (!textureShader->addVertexShader(OpenGLHelpers::translateVertexShaderToV3(vertexShader))
+		|| !textureShader->addFragmentShader(OpenGLHelpers::translateFragmentShaderToV3(fragmentShader))
+		|| !textureShader->link())
+	{
+		LOGERROR("Quad batcher : error compiling shader : " << textureShader->getLastError());
+		textureShader.reset();
+		return false;
+	}
+
+	GLuint programID = textureShader->getProgramID();
+
+	projectionLocation = glGetUniformLocation(programID, "projection");
+	useTextureLocation = glGetUniformLocation(programID, "useTexture");
+
+	textureShader->use();
+	glUniform1i(glGetUniformLocation(programID, "tex"), 0);
+	glUseProgram(0);
+
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, bufferQuads * 4 * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+	bufferOffset = 0;
+
+	//every quad uses the same 2 triangles, indices never change, batches are drawn with a base vertex
+	Array<GLushort> indices;
+	indices.ensureStorageAllocated(maxQuads * 6);
+	for (int i = 0; i < maxQuads; i++)
+	{
+		const int o = i * 4;
+		for (int k : { 0, 1, 2, 0, 2, 3 }) indices.add((GLushort)(o + k));
+	}
+
+	glGenBuffers(1, &ebo);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.getRawDataPointer(), GL_STATIC_DRAW);
+
+	GLint posAttrib = glGetAttribLocation(programID, "position");
+	GLint texAttrib = glGetAttribLocation(programID, "texCoord");
+	GLint colorAttrib = glGetAttribLocation(programID, "color");
+
+	if (posAttrib >= 0)
+	{
+		glEnableVertexAttribArray(posAttrib);
+		glVertexAttribPointer(posAttrib, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, x));
+	}
+
+	if (texAttrib >= 0)
+	{
+		glEnableVertexAttribArray(texAttrib);
+		glVertexAttribPointer(texAttrib, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, u));
+	}
+
+	if (colorAttrib >= 0)
+	{
+		glEnableVertexAttribArray(colorAttrib);
+		glVertexAttribPointer(colorAttrib, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, r));
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	return true;
+}
+
+void QuadBatcher::release()
+{
+	if (vao != 0) glDeleteVertexArrays(1, &vao);
+	if (vbo != 0) glDeleteBuffers(1, &vbo);
+	if (ebo != 0) glDeleteBuffers(1, &ebo);
+
+	vao = 0;
+	vbo = 0;
+	ebo = 0;
+	bufferOffset = 0;
+
+	textureShader.reset();
+	vertices.clearQuick();
+	isDrawing = false;
+}
+
+void QuadBatcher::begin(int width, int height, bool topDown)
+{
+	jassert(!isDrawing);
+
+	if (vao == 0 && !init()) return;
+
+	isDrawing = true;
+	vertices.clearQuick();
+	currentTexture = 0;
+	blendSrc = GL_SRC_ALPHA;
+	blendDst = GL_ONE_MINUS_SRC_ALPHA;
+
+	//same space as the old glOrtho helpers, y up unless topDown
+	projection[0] = 2.0f / jmax(width, 1);
+	projection[1] = (topDown ? -2.0f : 2.0f) / jmax(height, 1);
+	projection[2] = -1.0f;
+	projection[3] = topDown ? 1.0f : -1.0f;
+}
+
+void QuadBatcher::end()
+{
+	if (!isDrawing) return;
+
+	flush();
+	isDrawing = false;
+
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glUseProgram(0);
+}
+
+void QuadBatcher::setBlendFunc(GLenum src, GLenum dst)
+{
+	if (src == blendSrc && dst == blendDst) return;
+	flush();
+	blendSrc = src;
+	blendDst = dst;
+}
+
+void QuadBatcher::drawTexture(GLuint texture, Rectangle<float> area, Colour color, bool flipY, Rectangle<float> texArea, const AffineTransform& transform)
+{
+	if (flipY) texArea = Rectangle<float>(texArea.getX(), texArea.getBottom(), texArea.getWidth(), -texArea.getHeight());
+	addQuad(texture, area, color, texArea, transform);
+}
+
+void QuadBatcher::fillRect(Rectangle<float> area, Colour color)
+{
+	addQuad(0, area, color, Rectangle<float>(0, 0, 1, 1), AffineTransform());
+}
+
+void QuadBatcher::addQuad(GLuint texture, Rectangle<float> area, Colour color, Rectangle<float> texArea, const AffineTransform& transform)
+{
+	if (!isDrawing) return;
+
+	if (texture != currentTexture || vertices.size() >= maxQuads * 4) flush();
+	currentTexture = texture;
+
+	const float r = color.getFloatRed();
+	const float g = color.getFloatGreen();
+	const float b = color.getFloatBlue();
+	const float a = color.getFloatAlpha();
+
+	//area origin maps to the texArea origin, same winding as the old GL_QUADS helpers
+	Point<float> p[4] = { area.getTopLeft(), area.getTopRight(), area.getBottomRight(), area.getBottomLeft() };
+	const float u[4] = { texArea.getX(), texArea.getRight(), texArea.getRight(), texArea.getX() };
+	const float v[4] = { texArea.getY(), texArea.getY(), texArea.getBottom(), texArea.getBottom() };
+
+	for (int i = 0; i < 4; i++)
+	{
+		if (!transform.isIdentity()) p[i].applyTransform(transform);
+		vertices.add({ p[i].x, p[i].y, u[i], v[i], r, g, b, a });
+	}
+}
+
+void QuadBatcher::flush()
+{
+	if (vertices.isEmpty() || textureShader == nullptr) return;
+
+	textureShader->use();
+	glUniform4f(projectionLocation, projection[0], projection[1], projection[2], projection[3]);
+	glUniform1f(useTextureLocation, currentTexture != 0 ? 1.0f : 0.0f);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, currentTexture);
+	glBlendFunc(blendSrc, blendDst);
+
+	glBindVertexArray(vao);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+	const int numVertices = vertices.size();
+	const GLsizeiptr size = numVertices * sizeof(Vertex);
+
+	if (bufferOffset + numVertices > bufferQuads * 4)
+	{
+		//new storage, the driver keeps the old one alive until the draws reading it are done
+		glBufferData(GL_ARRAY_BUFFER, bufferQuads * 4 * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+		bufferOffset = 0;
+	}
+
+	//this range was never written since the storage was orphaned, no need to sync with pending draws
+	if (void* data = glMapBufferRange(GL_ARRAY_BUFFER, bufferOffset * sizeof(Vertex), size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT))
+	{
+		memcpy(data, vertices.getRawDataPointer(), size);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+	}
+	else
+	{
+		glBufferSubData(GL_ARRAY_BUFFER, bufferOffset * sizeof(Vertex), size, vertices.getRawDataPointer());
+	}
+
+	glDrawElementsBaseVertex(GL_TRIANGLES, numVertices / 4 * 6, GL_UNSIGNED_SHORT, nullptr, bufferOffset);
+	bufferOffset += numVertices;
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	vertices.clearQuick();
+}
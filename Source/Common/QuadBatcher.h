@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+	QuadBatcher.h
+	Created: 16 Oct 2026 11:12:08pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Core profile replacement for the old immediate mode quad helpers.
+// Quads are accumulated and drawn in as few draw calls as possible, a batch is only flushed when the texture
+// or blend function changes, or when it is full. Batches are streamed one after the other in the vertex buffer,
+// which is orphaned when it wraps, so a flush never waits for the draws of the previous ones.
+// VAOs are not shared between contexts, so each GL context owns its own batcher.
+class QuadBatcher
+{
+public:
+	QuadBatcher(OpenGLContext& context);
+	~QuadBatcher();
+
+	struct Vertex
+	{
+		float x, y;
+		float u, v;
+		float r, g, b, a;
+	};
+
+	static const int maxQuads = 1024; //per batch
+	static const int bufferQuads = maxQuads * 4; //per vertex buffer storage
+
+	OpenGLContext& context;
+
+	GLuint vao;
+	GLuint vbo;
+	GLuint ebo;
+
+	std::unique_ptr<OpenGLShaderProgram> textureShader;
+	GLint projectionLocation;
+	GLint useTextureLocation;
+	int bufferOffset; //vertices already written in the current storage
+
+	Array<Vertex> vertices;
+	GLuint currentTexture;
+	GLenum blendSrc;
+	GLenum blendDst;
+	bool isDrawing;
+
+	//pixel to clip space
+	float projection[4];
+
+	//GL thread, init is done lazily on first begin
+	bool init();
+	void release();
+
+	void begin(int width, int height, bool topDown = false);
+	void end();
+
+	void setBlendFunc(GLenum src, GLenum dst);
+
+	void drawTexture(GLuint texture, Rectangle<float> area, Colour color = Colours::white, bool flipY = false, Rectangle<float> texArea = Rectangle<float>(0, 0, 1, 1), const AffineTransform& transform = AffineTransform());
+	void fillRect(Rectangle<float> area, Colour color);
+
+	void flush();
+
+private:
+	void addQuad(GLuint texture, Rectangle<float> area, Colour color, Rectangle<float> texArea, const AffineTransform& transform);
+};
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+	RenderGraph.cpp
+	Created: 16 Oct 2026 10:12:04am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+RenderGraph::RenderGraph() :
+	isDirty(true)
+{
+}
+
+RenderGraph::~RenderGraph()
+{
+}
+
+Array<int> RenderGraph::computeRenderOrder(const Array<juce::OpenGLRenderer*>& renderers, const Array<bool>& isPresentation)
+{
+	const int n = renderers.size();
+
+	Array<Array<int>> consumers;
+	Array<int> numProducers;
+	consumers.resize(n);
+	numProducers.insertMultiple(0, 0, n);
+
+	for (int i = 0; i < n; i++)
+	{
+		if (isPresentation[i]) continue;
+
+		RenderGraphNode* node = dynamic_cast<RenderGraphNode*>(renderers[i]);
+		if (node == nullptr) continue;
+
+		Array<juce::OpenGLRenderer*> nodeConsumers;
+		node->getRenderConsumers(nodeConsumers);
+		node->renderConsumers.clearQuick();
+
+		for (auto& c : nodeConsumers)
+		{
+			int ci = renderers.indexOf(c);
+			if (ci < 0 || ci == i || isPresentation[ci] || consumers.getReference(i).contains(ci)) continue;
+			consumers.getReference(i).add(ci);
+			numProducers.set(ci, numProducers[ci] + 1);
+			node->renderConsumers.add(c);
+		}
+	}
+
+	//Kahn's algorithm, always picking the lowest registration index available to keep the order stable
+	Array<int> result;
+	SortedSet<int> ready;
+	for (int i = 0; i < n; i++) if (!isPresentation[i] && numProducers[i] == 0) ready.add(i);
+
+	while (!ready.isEmpty())
+	{
+		int i = ready.getFirst();
+		ready.remove(0);
+		result.add(i);
+
+		for (auto& ci : consumers.getReference(i))
+		{
+			numProducers.set(ci, numProducers[ci] - 1);
+			if (numProducers[ci] == 0) ready.add(ci);
+		}
+	}
+
+	Array<juce::OpenGLRenderer*> cycle;
+	for (int i = 0; i < n; i++)
+	{
+		if (isPresentation[i] || numProducers[i] == 0) continue;
+		result.add(i);
+		cycle.add(renderers[i]);
+	}
+
+	if (cycle != cycleRenderers)
+	{
+		cycleRenderers = cycle;
+		if (!cycle.isEmpty())
+		{
+			StringArray names;
+			for (auto& r : cycle) if (RenderGraphNode* node = dynamic_cast<RenderGraphNode*>(r)) names.add(node->getRenderNodeName());
+			LOGWARNING("Render cycle detected involving " << names.joinIntoString(", ") << ", these will be rendered with one frame of latency");
+		}
+	}
+
+	updateLiveNodes(renderers, isPresentation, consumers, result);
+
+	for (int i = 0; i < n; i++) if (isPresentation[i]) result.add(i);
+
+	return result;
+}
+
+void RenderGraph::updateLiveNodes(const Array<juce::OpenGLRenderer*>& renderers, const Array<bool>& isPresentation, Array<Array<int>>& consumers, const Array<int>& order)
+{
+	const int n = renderers.size();
+
+	Array<bool> live;
+	for (int i = 0; i < n; i++) live.add(isPresentation[i] || dynamic_cast<RenderGraphNode*>(renderers[i]) == nullptr);
+
+	//pull from the roots, walking the order backwards so consumers are resolved before their producers. Loop again only if a cycle made this pass incomplete
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (int k = order.size() - 1; k >= 0; k--)
+		{
+			int i = order[k];
+			if (live[i]) continue;
+
+			for (auto& ci : consumers.getReference(i))
+			{
+				if (!live[ci]) continue;
+				live.set(i, true);
+				changed = true;
+				break;
+			}
+		}
+	}
+
+	for (int i = 0; i < n; i++)
+	{
+		if (RenderGraphNode* node = dynamic_cast<RenderGraphNode*>(renderers[i])) node->isRenderLive = live[i];
+	}
+}
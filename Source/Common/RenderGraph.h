@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+	RenderGraph.h
+	Created: 16 Oct 2026 10:12:04am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Implemented by renderers that feed other renderers (medias sampled by compositions, sequences or screens)
+class RenderGraphNode
+{
+public:
+	RenderGraphNode() : isRenderLive(false) {}
+	virtual ~RenderGraphNode() {}
+
+	//updated by the RenderGraph each time it is rebuilt, only valid on the GL thread
+	bool isRenderLive;
+	Array<juce::OpenGLRenderer*> renderConsumers;
+
+	virtual void getRenderConsumers(Array<juce::OpenGLRenderer*>& consumers) = 0;
+	virtual String getRenderNodeName() const = 0;
+};
+
+class RenderGraph
+{
+public:
+	RenderGraph();
+	~RenderGraph();
+
+	std::atomic<bool> isDirty;
+	Array<juce::OpenGLRenderer*> cycleRenderers;
+
+	void setDirty() { isDirty = true; }
+
+	// Returns renderer indices so that every producer is rendered before its consumers.
+	// Presentation renderers (components) are always rendered last, in registration order.
+	// Renderers that are part of a cycle are appended after the sorted ones, in registration order.
+	// Nodes are only marked live if they are pulled by a renderer that is not a node itself (screens, components...).
+	Array<int> computeRenderOrder(const Array<juce::OpenGLRenderer*>& renderers, const Array<bool>& isPresentation);
+
+private:
+	void updateLiveNodes(const Array<juce::OpenGLRenderer*>& renderers, const Array<bool>& isPresentation, Array<Array<int>>& consumers, const Array<int>& order);
+};
@@ -0,0 +1,262 @@
+/*
+  ==============================================================================
+
+	RenderTimer.cpp
+	Created: 16 Oct 2026 2:41:18pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+using namespace juce::gl;
+
+RenderTimer::RenderTimer(const String& name) :
+	ControllableContainer(name),
+	gpuSupported(false),
+	queriesInitialized(false),
+	queryIndex(0),
+	isTiming(false),
+	missedDeadlineCount(0),
+	uploadedBytes(0),
+	cpuTimeAtBegin(0),
+	lastPublishTime(0),
+	publishedGpuLast(0),
+	publishedGpuAvg(0),
+	publishedGpuP99(0),
+	publishedCpuLast(0),
+	publishedCpuAvg(0),
+	publishedCpuP99(0),
+	publishedMissedDeadlines(0),
+	gpuHistoryIndex(0),
+	cpuHistoryIndex(0),
+	isRecording(false),
+	missedAtRecordStart(0),
+	uploadedAtRecordStart(0),
+	recordedMissedDeadlines(0),
+	recordedUploadedBytes(0)
+{
+	gpuLast = addFloatParameter("GPU Last", "GPU time of the last measured frame, in milliseconds", 0, 0);
+	gpuAvg = addFloatParameter("GPU Avg", "Average GPU time over the last frames, in milliseconds", 0, 0);
+	gpuP99 = addFloatParameter("GPU P99", "99th percentile of the GPU time over the last frames, in milliseconds", 0, 0);
+	cpuLast = addFloatParameter("CPU Last", "CPU time of the last frame, in milliseconds", 0, 0);
+	cpuAvg = addFloatParameter("CPU Avg", "Average CPU time over the last frames, in milliseconds", 0, 0);
+	cpuP99 = addFloatParameter("CPU P99", "99th percentile of the CPU time over the last frames, in milliseconds", 0, 0);
+	missedDeadlines = addIntParameter("Missed Deadlines", "Number of frames that could not be rendered in time since the start", 0, 0);
+
+	for (auto& c : controllables)
+	{
+		c->isSavable = false;
+		c->enabled = false;
+	}
+
+	for (int i = 0; i < numQueries; i++)
+	{
+		startQueries[i] = 0;
+		endQueries[i] = 0;
+		pendingQueries[i] = false;
+	}
+
+	StatsPublisher::getInstance()->addSource(this);
+}
+
+RenderTimer::~RenderTimer()
+{
+	if (StatsPublisher::getInstanceWithoutCreating() != nullptr) StatsPublisher::getInstance()->removeSource(this);
+}
+
+void RenderTimer::begin()
+{
+	if (!queriesInitialized)
+	{
+		gpuSupported = OpenGLHelpers::isExtensionSupported("GL_ARB_timer_query");
+		if (gpuSupported)
+		{
+			glGenQueries(numQueries, startQueries);
+			glGenQueries(numQueries, endQueries);
+		}
+		queriesInitialized = true;
+	}
+
+	if (gpuSupported)
+	{
+		collectQueries();
+
+		//ring is full of results still in flight, drop this one rather than waiting for the GPU
+		if (!pendingQueries[queryIndex]) glQueryCounter(startQueries[queryIndex], GL_TIMESTAMP);
+	}
+
+	cpuTimeAtBegin = Time::getMillisecondCounterHiRes();
+	isTiming = true;
+}
+
+void RenderTimer::end()
+{
+	if (!isTiming) return;
+	isTiming = false;
+
+	double t = Time::getMillisecondCounterHiRes();
+	addSample(cpuHistory, cpuHistoryIndex, (float)(t - cpuTimeAtBegin));
+	if (isRecording) cpuRecord.add((float)(t - cpuTimeAtBegin));
+
+	if (gpuSupported && !pendingQueries[queryIndex])
+	{
+		glQueryCounter(endQueries[queryIndex], GL_TIMESTAMP);
+		pendingQueries[queryIndex] = true;
+		queryIndex = (queryIndex + 1) % numQueries;
+	}
+
+	if (t > lastPublishTime + 500)
+	{
+		lastPublishTime = t;
+		publish();
+	}
+}
+
+void RenderTimer::release()
+{
+	if (queriesInitialized && gpuSupported)
+	{
+		glDeleteQueries(numQueries, startQueries);
+		glDeleteQueries(numQueries, endQueries);
+	}
+
+	for (int i = 0; i < numQueries; i++) pendingQueries[i] = false;
+	queriesInitialized = false;
+	queryIndex = 0;
+	isTiming = false;
+}
+
+void RenderTimer::setMissedDeadlines(int count)
+{
+	missedDeadlineCount = count;
+}
+
+void RenderTimer::addUpload(int64 bytes)
+{
+	uploadedBytes += bytes;
+}
+
+void RenderTimer::startRecording()
+{
+	gpuRecord.clearQuick();
+	cpuRecord.clearQuick();
+	missedAtRecordStart = missedDeadlineCount;
+	uploadedAtRecordStart = uploadedBytes;
+	recordedMissedDeadlines = 0;
+	recordedUploadedBytes = 0;
+	isRecording = true;
+}
+
+void RenderTimer::stopRecording()
+{
+	if (!isRecording) return;
+	isRecording = false;
+	recordedMissedDeadlines = missedDeadlineCount - missedAtRecordStart;
+	recordedUploadedBytes = uploadedBytes - uploadedAtRecordStart;
+}
+
+var RenderTimer::getRecordReport(double duration)
+{
+	var data(new DynamicObject());
+	data.getDynamicObject()->setProperty("cpu", getDistribution(cpuRecord));
+	data.getDynamicObject()->setProperty("gpu", getDistribution(gpuRecord));
+	data.getDynamicObject()->setProperty("renderedFrames", cpuRecord.size());
+	data.getDynamicObject()->setProperty("droppedFrames", recordedMissedDeadlines);
+	data.getDynamicObject()->setProperty("uploadMBps", duration > 0 ? recordedUploadedBytes / (1024.0 * 1024.0) / duration : 0);
+	return data;
+}
+
+void RenderTimer::collectQueries()
+{
+	//oldest query first, stop at the first one that is not ready to keep the samples in order
+	for (int i = 0; i < numQueries; i++)
+	{
+		int index = (queryIndex + i) % numQueries;
+		if (!pendingQueries[index]) continue;
+
+		GLint available = 0;
+		glGetQueryObjectiv(endQueries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available) break;
+
+		GLuint64 startTime = 0, endTime = 0;
+		glGetQueryObjectui64v(startQueries[index], GL_QUERY_RESULT, &startTime);
+		glGetQueryObjectui64v(endQueries[index], GL_QUERY_RESULT, &endTime);
+		pendingQueries[index] = false;
+
+		float gpuTime = (float)((endTime - startTime) / 1000000.0);
+		addSample(gpuHistory, gpuHistoryIndex, gpuTime);
+		if (isRecording) gpuRecord.add(gpuTime);
+	}
+}
+
+void RenderTimer::publish()
+{
+	float gLast = gpuHistory.isEmpty() ? 0 : gpuHistory[(gpuHistoryIndex + gpuHistory.size() - 1) % gpuHistory.size()];
+	float cLast = cpuHistory.isEmpty() ? 0 : cpuHistory[(cpuHistoryIndex + cpuHistory.size() - 1) % cpuHistory.size()];
+
+	float gAvg = 0, gP99 = 0, cAvg = 0, cP99 = 0;
+	getStats(gpuHistory, gAvg, gP99);
+	getStats(cpuHistory, cAvg, cP99);
+
+	publishedGpuLast = gLast;
+	publishedGpuAvg = gAvg;
+	publishedGpuP99 = gP99;
+	publishedCpuLast = cLast;
+	publishedCpuAvg = cAvg;
+	publishedCpuP99 = cP99;
+	publishedMissedDeadlines = missedDeadlineCount.load();
+}
+
+void RenderTimer::publishStats()
+{
+	gpuLast->setValue(publishedGpuLast.load());
+	gpuAvg->setValue(publishedGpuAvg.load());
+	gpuP99->setValue(publishedGpuP99.load());
+	cpuLast->setValue(publishedCpuLast.load());
+	cpuAvg->setValue(publishedCpuAvg.load());
+	cpuP99->setValue(publishedCpuP99.load());
+	missedDeadlines->setValue(publishedMissedDeadlines.load());
+}
+
+void RenderTimer::addSample(Array<float>& history, int& index, float value)
+{
+	if (history.size() < historySize) history.add(value);
+	else history.set(index, value);
+	index = (index + 1) % historySize;
+}
+
+void RenderTimer::getStats(const Array<float>& history, float& avg, float& p99)
+{
+	if (history.isEmpty()) return;
+
+	Array<float> sorted(history);
+	sorted.sort();
+
+	float sum = 0;
+	for (auto& v : sorted) sum += v;
+	avg = sum / sorted.size();
+	p99 = sorted[jmin(sorted.size() - 1, (int)(sorted.size() * .99f))];
+}
+
+var RenderTimer::getDistribution(const Array<float>& samples)
+{
+	var data(new DynamicObject());
+	if (samples.isEmpty()) return data;
+
+	Array<float> sorted(samples);
+	sorted.sort();
+
+	double sum = 0;
+	for (auto& v : sorted) sum += v;
+
+	auto percentile = [&sorted](float p) { return sorted[jmin(sorted.size() - 1, (int)(sorted.size() * p))]; };
+
+	data.getDynamicObject()->setProperty("mean", sum / sorted.size());
+	data.getDynamicObject()->setProperty("p50", percentile(.5f));
+	data.getDynamicObject()->setProperty("p95", percentile(.95f));
+	data.getDynamicObject()->setProperty("p99", percentile(.99f));
+	data.getDynamicObject()->setProperty("max", sorted.getLast());
+	return data;
+}
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+	RenderTimer.h
+	Created: 16 Oct 2026 2:41:18pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Measures CPU and GPU time spent between begin() and end(), called from the GL thread.
+// GPU time uses timestamp queries (so timers can be nested) kept in a ring and read back a few frames later,
+// results that are not available yet are skipped instead of stalling the pipeline.
+// Stats are computed on the GL thread and picked up by the StatsPublisher to update the parameters.
+class RenderTimer :
+	public ControllableContainer,
+	public StatsPublisher::Source
+{
+public:
+	RenderTimer(const String& name = "Render Stats");
+	~RenderTimer();
+
+	static const int numQueries = 4;
+	static const int historySize = 120;
+
+	FloatParameter* gpuLast;
+	FloatParameter* gpuAvg;
+	FloatParameter* gpuP99;
+	FloatParameter* cpuLast;
+	FloatParameter* cpuAvg;
+	FloatParameter* cpuP99;
+	IntParameter* missedDeadlines;
+
+	//GL thread
+	bool gpuSupported;
+	bool queriesInitialized;
+	GLuint startQueries[numQueries];
+	GLuint endQueries[numQueries];
+	bool pendingQueries[numQueries];
+	int queryIndex;
+	bool isTiming;
+
+	//written by the GL and upload threads
+	std::atomic<int> missedDeadlineCount;
+	std::atomic<int64> uploadedBytes;
+
+	double cpuTimeAtBegin;
+	double lastPublishTime;
+
+	//written by the GL thread, read by the message thread
+	std::atomic<float> publishedGpuLast;
+	std::atomic<float> publishedGpuAvg;
+	std::atomic<float> publishedGpuP99;
+	std::atomic<float> publishedCpuLast;
+	std::atomic<float> publishedCpuAvg;
+	std::atomic<float> publishedCpuP99;
+	std::atomic<int> publishedMissedDeadlines;
+
+	Array<float> gpuHistory;
+	Array<float> cpuHistory;
+	int gpuHistoryIndex;
+	int cpuHistoryIndex;
+
+	//full recording of the samples, used by benchmarks
+	bool isRecording;
+	Array<float> gpuRecord;
+	Array<float> cpuRecord;
+	int missedAtRecordStart;
+	int64 uploadedAtRecordStart;
+	int recordedMissedDeadlines; //latched when the recording stops
+	int64 recordedUploadedBytes;
+
+	void begin();
+	void end();
+	void release();
+	void setMissedDeadlines(int count);
+	void addUpload(int64 bytes);
+
+	void startRecording();
+	void stopRecording();
+	var getRecordReport(double duration);
+
+	void collectQueries();
+	void publish();
+
+	//message thread
+	void publishStats() override;
+
+	static void addSample(Array<float>& history, int& index, float value);
+	static void getStats(const Array<float>& history, float& avg, float& p99);
+	static var getDistribution(const Array<float>& samples);
+};
@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+	StatsPublisher.cpp
+	Created: 17 Oct 2026 12:04:51am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+juce_ImplementSingleton(StatsPublisher);
+
+FrameTimeRing::FrameTimeRing() :
+	writeIndex(0)
+{
+	for (auto& t : times) t.store(0, std::memory_order_relaxed);
+}
+
+void FrameTimeRing::push(double time)
+{
+	uint32 index = writeIndex.load(std::memory_order_relaxed);
+	times[index % ringSize].store(time, std::memory_order_relaxed);
+	writeIndex.store(index + 1, std::memory_order_release);
+}
+
+float FrameTimeRing::getFPS(double now, int numFrames) const
+{
+	uint32 index = writeIndex.load(std::memory_order_acquire);
+	if (index < 2) return 0;
+
+	//keep clear of the slots the writer may be overwriting
+	uint32 numIntervals = (uint32)jlimit(1, ringSize / 2, numFrames);
+	numIntervals = jmin(numIntervals, index - 1);
+
+	double newest = times[(index - 1) % ringSize].load(std::memory_order_relaxed);
+	double oldest = times[(index - 1 - numIntervals) % ringSize].load(std::memory_order_relaxed);
+
+	if (now - newest > 1000) return 0;
+	if (newest <= oldest) return 0;
+
+	return (float)(numIntervals * 1000.0 / (newest - oldest));
+}
+
+
+
+StatsPublisher::StatsPublisher()
+{
+	startTimer(publishInterval);
+}
+
+StatsPublisher::~StatsPublisher()
+{
+	stopTimer();
+}
+
+void StatsPublisher::addSource(Source* s)
+{
+	jassert(MessageManager::getInstance()->isThisTheMessageThread());
+	sources.addIfNotAlreadyThere(s);
+}
+
+void StatsPublisher::removeSource(Source* s)
+{
+	jassert(MessageManager::getInstance()->isThisTheMessageThread());
+	sources.removeAllInstancesOf(s);
+}
+
+void StatsPublisher::timerCallback()
+{
+	if (Engine::mainEngine != nullptr && (Engine::mainEngine->isClearing || Engine::mainEngine->isLoadingFile)) return;
+
+	for (auto& s : sources) s->publishStats();
+}
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+	StatsPublisher.h
+	Created: 17 Oct 2026 12:04:51am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Ring of frame timestamps written by a single thread (GL or decoder) without locking or allocating,
+// the message thread reads the latest timestamps to compute the frame rate.
+class FrameTimeRing
+{
+public:
+	FrameTimeRing();
+	~FrameTimeRing() {}
+
+	static const int ringSize = 64;
+
+	std::atomic<double> times[ringSize];
+	std::atomic<uint32> writeIndex;
+
+	//writer thread
+	void push(double time);
+
+	//any thread, 0 if no frame was pushed in the last second
+	float getFPS(double now, int numFrames = 10) const;
+};
+
+// Message thread timer publishing the metrics gathered by the render and decoder threads to their parameters,
+// at a fixed low rate instead of posting a message for each frame.
+class StatsPublisher :
+	public Timer
+{
+public:
+	juce_DeclareSingleton(StatsPublisher, true);
+
+	StatsPublisher();
+	~StatsPublisher();
+
+	class Source
+	{
+	public:
+		virtual ~Source() {}
+		virtual void publishStats() = 0;
+	};
+
+	static const int publishInterval = 200;
+
+	//message thread
+	Array<Source*> sources;
+	void addSource(Source* s);
+	void removeSource(Source* s);
+
+	void timerCallback() override;
+};
@@ -0,0 +1,236 @@
+/*
+  ==============================================================================
+
+	RMPBenchmark.cpp
+	Created: 16 Oct 2026 8:34:10pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "RMPEngine.h"
+#include "RMPBenchmark.h"
+#include "Screen/ScreenIncludes.h"
+#include "Media/MediaIncludes.h"
+
+juce_ImplementSingleton(RMPBenchmark);
+
+RMPBenchmark::RMPBenchmark() :
+	state(IDLE),
+	numFrames(600),
+	warmupFrames(60),
+	tickAtStateStart(0),
+	timeAtRecordStart(0)
+{
+}
+
+RMPBenchmark::~RMPBenchmark()
+{
+	stopTimer();
+}
+
+bool RMPBenchmark::isRequested(const String& commandLine)
+{
+	StringArray args;
+	args.addTokens(commandLine, true);
+	return args.contains("-benchmark");
+}
+
+void RMPBenchmark::setup(const String& commandLine)
+{
+	StringArray args;
+	args.addTokens(commandLine, true);
+
+	auto getArg = [&args](const String& name)
+		{
+			int index = args.indexOf(name);
+			return index >= 0 && index < args.size() - 1 ? args[index + 1].unquoted() : String();
+		};
+
+	projectFile = File::getCurrentWorkingDirectory().getChildFile(getArg("-benchmark"));
+
+	String output = getArg("-output");
+	outputFile = output.isNotEmpty() ? File::getCurrentWorkingDirectory().getChildFile(output) : projectFile.getSiblingFile(projectFile.getFileNameWithoutExtension() + "_benchmark.json");
+
+	if (getArg("-frames").isNotEmpty()) numFrames = jmax(1, getArg("-frames").getIntValue());
+	if (getArg("-warmup").isNotEmpty()) warmupFrames = jmax(0, getArg("-warmup").getIntValue());
+
+	StringArray size = StringArray::fromTokens(getArg("-size"), "x", "");
+	if (size.size() == 2) screenSize = Point<int>(size[0].getIntValue(), size[1].getIntValue());
+}
+
+void RMPBenchmark::start()
+{
+	if (!projectFile.existsAsFile())
+	{
+		LOGERROR("Benchmark : project file not found " << projectFile.getFullPathName());
+		JUCEApplication::quit();
+		return;
+	}
+
+	LOG("Benchmark : loading " << projectFile.getFullPathName());
+
+	state = LOADING;
+	Result r = Engine::mainEngine->loadFrom(projectFile, false);
+	if (r.failed())
+	{
+		LOGERROR("Benchmark : could not load project : " << r.getErrorMessage());
+		JUCEApplication::quit();
+		return;
+	}
+
+	startTimer(50);
+}
+
+void RMPBenchmark::timerCallback()
+{
+	int64 ticks = GlContextHolder::getInstance()->frameScheduler.numTicks;
+
+	switch (state)
+	{
+	case LOADING:
+		if (Engine::mainEngine->isLoadingFile) return;
+
+		if (!screenSize.isOrigin())
+		{
+			for (auto& s : ScreenManager::getInstance()->items)
+			{
+				s->screenWidth->setValue(screenSize.x);
+				s->screenHeight->setValue(screenSize.y);
+			}
+		}
+
+		state = WARMUP;
+		tickAtStateStart = ticks;
+		break;
+
+	case WARMUP:
+		if (ticks - tickAtStateStart < warmupFrames) return;
+		startRecording();
+		break;
+
+	case RECORDING:
+		if (ticks - tickAtStateStart < numFrames) return;
+		finish();
+		break;
+
+	default:
+		break;
+	}
+}
+
+void RMPBenchmark::startRecording()
+{
+	//records are only touched by the GL thread rendering them
+	GlContextHolder::getInstance()->executeOnProductionThread([this]() { setMediasRecording(true); }, true);
+	GlContextHolder::getInstance()->executeOnGLThread([this]() { setScreensRecording(true); }, true);
+
+	state = RECORDING;
+	tickAtStateStart = GlContextHolder::getInstance()->frameScheduler.numTicks;
+	timeAtRecordStart = Time::getMillisecondCounterHiRes();
+
+	LOG("Benchmark : recording " << numFrames << " frames");
+}
+
+void RMPBenchmark::finish()
+{
+	stopTimer();
+
+	double duration = (Time::getMillisecondCounterHiRes() - timeAtRecordStart) / 1000.0;
+	int64 numTicks = GlContextHolder::getInstance()->frameScheduler.numTicks - tickAtStateStart;
+
+	var report;
+	GlContextHolder::getInstance()->executeOnProductionThread([this]() { setMediasRecording(false); }, true);
+	GlContextHolder::getInstance()->executeOnGLThread([this, &report, duration, numTicks]()
+		{
+			setScreensRecording(false);
+			report = createReport(duration, numTicks);
+		}, true);
+
+	state = DONE;
+
+	if (outputFile.replaceWithText(JSON::toString(report))) LOG("Benchmark : report written to " << outputFile.getFullPathName());
+	else LOGERROR("Benchmark : could not write report to " << outputFile.getFullPathName());
+
+	JUCEApplication::quit();
+}
+
+void RMPBenchmark::setScreensRecording(bool value)
+{
+	for (auto& s : ScreenManager::getInstance()->items)
+	{
+		if (value) s->renderTimer.startRecording();
+		else s->renderTimer.stopRecording();
+	}
+}
+
+void RMPBenchmark::setMediasRecording(bool value)
+{
+	for (auto& m : getAllMedias())
+	{
+		if (value) m->renderTimer.startRecording();
+		else m->renderTimer.stopRecording();
+	}
+}
+
+Array<Media*> RMPBenchmark::getAllMedias()
+{
+	Array<Media*> medias;
+	for (auto& m : MediaManager::getInstance()->items) addMediaTree(m, medias);
+	return medias;
+}
+
+void RMPBenchmark::addMediaTree(Media* m, Array<Media*>& medias)
+{
+	medias.add(m);
+
+	SequenceMedia* sm = dynamic_cast<SequenceMedia*>(m);
+	if (sm == nullptr) return;
+
+	for (auto& l : sm->sequence.layerManager->getItemsWithType<MediaLayer>())
+	{
+		for (auto& c : l->blockManager.getItemsWithType<OwnedMediaClip>())
+		{
+			if (c->ownedMedia != nullptr) addMediaTree(c->ownedMedia.get(), medias);
+		}
+	}
+}
+
+var RMPBenchmark::createReport(double duration, int64 numTicks)
+{
+	var report(new DynamicObject());
+	report.getDynamicObject()->setProperty("project", projectFile.getFullPathName());
+	report.getDynamicObject()->setProperty("version", JUCEApplication::getInstance()->getApplicationVersion());
+	report.getDynamicObject()->setProperty("renderer", String((const char*)juce::gl::glGetString(juce::gl::GL_RENDERER)));
+	report.getDynamicObject()->setProperty("fpsLimit", GlContextHolder::getInstance()->frameScheduler.globalFPS);
+	if (!screenSize.isOrigin()) report.getDynamicObject()->setProperty("resolution", String(screenSize.x) + "x" + String(screenSize.y));
+	report.getDynamicObject()->setProperty("frames", numTicks);
+	report.getDynamicObject()->setProperty("duration", duration);
+	report.getDynamicObject()->setProperty("averageFPS", duration > 0 ? numTicks / duration : 0);
+
+	var screens;
+	for (auto& s : ScreenManager::getInstance()->items)
+	{
+		var data = s->renderTimer.getRecordReport(duration);
+		data.getDynamicObject()->setProperty("name", s->niceName);
+		data.getDynamicObject()->setProperty("width", s->screenWidth->intValue());
+		data.getDynamicObject()->setProperty("height", s->screenHeight->intValue());
+		screens.append(data);
+	}
+	report.getDynamicObject()->setProperty("screens", screens);
+
+	var medias;
+	double totalUpload = 0;
+	for (auto& m : getAllMedias())
+	{
+		var data = m->renderTimer.getRecordReport(duration);
+		data.getDynamicObject()->setProperty("name", m->niceName);
+		data.getDynamicObject()->setProperty("type", m->getTypeString());
+		totalUpload += (double)data.getProperty("uploadMBps", 0);
+		medias.append(data);
+	}
+	report.getDynamicObject()->setProperty("medias", medias);
+	report.getDynamicObject()->setProperty("uploadMBps", totalUpload);
+
+	return report;
+}
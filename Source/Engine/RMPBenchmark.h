@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+	RMPBenchmark.h
+	Created: 16 Oct 2026 8:34:10pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class Media;
+
+// Loads a project, renders it headlessly for a number of frames and writes a JSON report
+// with the frame time distributions of every screen and media.
+// RuleMaPool -benchmark show.poule [-frames 600] [-warmup 60] [-size 1920x1080] [-output report.json]
+class RMPBenchmark :
+	public Timer
+{
+public:
+	juce_DeclareSingleton(RMPBenchmark, true);
+
+	RMPBenchmark();
+	~RMPBenchmark();
+
+	enum State { IDLE, LOADING, WARMUP, RECORDING, DONE };
+	State state;
+
+	File projectFile;
+	File outputFile;
+	int numFrames;
+	int warmupFrames;
+	Point<int> screenSize;
+
+	int64 tickAtStateStart;
+	double timeAtRecordStart;
+
+	static bool isRequested(const String& commandLine);
+	void setup(const String& commandLine);
+	void start();
+
+	void timerCallback() override;
+
+	void startRecording();
+	void finish();
+
+	void setScreensRecording(bool value);
+	void setMediasRecording(bool value);
+	//all the medias of the project, including the ones owned by sequence clips
+	Array<Media*> getAllMedias();
+	void addMediaTree(Media* m, Array<Media*>& medias);
+	var createReport(double duration, int64 numTicks);
+};
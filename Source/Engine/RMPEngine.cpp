@@ -39,6 +39,7 @@ RMPEngine::RMPEngine() :
 	addChildControllableContainer(ScreenManager::getInstance());
 
 	ProjectSettings::getInstance()->addChildControllableContainer(RMPSettings::getInstance());
+	RMPSettings::getInstance()->addChildControllableContainer(&GlContextHolder::getInstance()->readback);
 
 	// MIDIManager::getInstance(); //Trigger constructor, declare settings
 
@@ -79,12 +80,15 @@ RMPEngine::~RMPEngine()
 	// CVGroupManager::deleteInstance();
 
 	// Guider::deleteInstance();
+	SurfaceMeshBuilder::deleteInstance();
 	MediaManager::deleteInstance();
 	ScreenManager::deleteInstance();
+	ScreenRecorder::joinWriters(5000); //the recordings stopped with their screens, let the encoders finish the files
 	NDIManager::deleteInstance();
 	WebcamManager::deleteInstance();
 	RMPSettings::deleteInstance();
 	MediaClipFactory::deleteInstance();
+	StatsPublisher::deleteInstance();
     if(VLCInstance != nullptr) libvlc_release(VLCInstance);
 	VLCInstance = nullptr;
 }
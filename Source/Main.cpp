@@ -2,6 +2,9 @@
 
 #include "MainIncludes.h"
 #include "Engine/RMPEngine.h"
+#include "Engine/RMPBenchmark.h"
+
+#include <csignal>
 
 RuleMaPoolApplication::RuleMaPoolApplication() :
 	OrganicApplication("RuleMaPool", true, ImageCache::getFromMemory(BinaryData::icon_png, BinaryData::icon_pngSize))
@@ -9,10 +12,22 @@ RuleMaPoolApplication::RuleMaPoolApplication() :
 }
 
 
-void RuleMaPoolApplication::initialiseInternal(const String&)
+void RuleMaPoolApplication::initialiseInternal(const String& commandLine)
 {
+#if !JUCE_WINDOWS
+	//writing to an encoder or a socket that closed fails instead of killing the app
+	signal(SIGPIPE, SIG_IGN);
+#endif
+
+	if (RMPBenchmark::isRequested(commandLine))
+	{
+		useWindow = false;
+		RMPBenchmark::getInstance()->setup(commandLine);
+	}
+
 	engine.reset(new RMPEngine());
 	if (useWindow) mainComponent.reset(new MainContentComponent());
+	else GlContextHolder::getInstance()->setupHeadless();
 
 	//Call after engine init
 	AppUpdater::getInstance()->setURLs("https://benjamin.kuperberg.fr/rulemapool/releases/update.json", "https://benjamin.kuperberg.fr/rulemapool/download/app", "RuleMaPool");
@@ -29,6 +44,8 @@ void RuleMaPoolApplication::initialiseInternal(const String&)
 
 void RuleMaPoolApplication::afterInit()
 {
+	if (RMPBenchmark::getInstanceWithoutCreating() != nullptr) RMPBenchmark::getInstance()->start();
+
 	//ANALYTICS
 	if (mainWindow != nullptr)
 	{
@@ -44,8 +61,12 @@ void RuleMaPoolApplication::afterInit()
 
 void RuleMaPoolApplication::shutdown()
 {
+	RMPBenchmark::deleteInstance();
 	OrganicApplication::shutdown();
 	AppUpdater::deleteInstance();
+
+	//with a window, the main component owns the context holder
+	if (!useWindow) GlContextHolder::deleteInstance();
 }
 
 void RuleMaPoolApplication::handleCrashed()
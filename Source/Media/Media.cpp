@@ -19,10 +19,8 @@ Media::Media(const String& name, var params, bool hasCustomSize) :
 	mediaParams("Media Parameters"),
 	alwaysRedraw(false),
 	shouldRedraw(false),
+	renderedFrames(0),
 	flipY(false),
-	timeAtLastRender(0),
-	lastFPSTick(0),
-	lastFPSIndex(0),
 	customFPSTick(false)
 {
 	addChildControllableContainer(&mediaParams);
@@ -33,11 +31,16 @@ Media::Media(const String& name, var params, bool hasCustomSize) :
 		height = addIntParameter("Height", "Height of the media", 1080, 1, 10000);
 	}
 
+	renderFPS = addIntParameter("Render FPS", "Target render rate of this media, capped by the global FPS limit. 0 follows the global limit", 0, 0, 360);
+
 	currentFPS = addFloatParameter("current FPS", "", 0, 0, 60);
 	currentFPS->isSavable = false;
 	currentFPS->enabled = false;
 
+	addChildControllableContainer(&renderTimer);
+
 	GlContextHolder::getInstance()->registerOpenGlRenderer(this);
+	StatsPublisher::getInstance()->addSource(this);
 	saveAndLoadRecursiveData = true;
 
 	itemDataType = "Media";
@@ -45,6 +48,7 @@ Media::Media(const String& name, var params, bool hasCustomSize) :
 
 Media::~Media()
 {
+	if (StatsPublisher::getInstanceWithoutCreating() != nullptr) StatsPublisher::getInstance()->removeSource(this);
 	if (GlContextHolder::getInstanceWithoutCreating() != nullptr) GlContextHolder::getInstance()->unregisterOpenGlRenderer(this);
 }
 
@@ -73,47 +77,67 @@ void Media::renderOpenGL()
 	preRenderGLInternal(); //allow for pre-rendering operations even if not being used or disabled
 
 	if (!enabled->boolValue()) return;
-	if (!isBeingUsed()) return;
-
-	const double frameTime = 1000.0 / RMPSettings::getInstance()->fpsLimit->intValue();
-	double t = GlContextHolder::getInstance()->timeAtRender;
-	if (t < timeAtLastRender + frameTime) return;
+	if (!isRenderLive) return; //not pulled by any enabled surface this frame
 
-	//log delta
-	//LOG("Delta: " << t - timeAtLastRender);
-	timeAtLastRender = t;
+	GlContextHolder* holder = GlContextHolder::getInstance();
+	//offline recordings step the time themselves, every frame has to be rendered
+	const int fps = holder->offlineRenderers > 0 ? 0 : renderFPS->intValue();
+	if (!holder->getFrameScheduler().shouldRender(renderSlot, fps)) return;
+	renderTimer.setMissedDeadlines(renderSlot.missedDeadlines);
 
 	if (!frameBuffer.isValid()) return;
 
 	if (shouldRedraw || alwaysRedraw)
 	{
 		frameBuffer.makeCurrentRenderingTarget();
+		renderTimer.begin();
 		renderGLInternal();
+		renderTimer.end();
 		frameBuffer.releaseAsRenderingTarget();
 		shouldRedraw = false;
+		renderedFrames++;
+
+		//frameBuffer keeps being drawn into, readers on other threads get a fenced copy
+		if (holder->isProductionThread()) handoff.publish(frameBuffer);
 
 		if (!customFPSTick) FPSTick();
+
+		//consumers are rendered after this media in the same frame, make sure they pick up the new content
+		for (auto& c : renderConsumers) if (Media* m = dynamic_cast<Media*>(c)) m->shouldRedraw = true;
 	}
 }
 
 OpenGLFrameBuffer* Media::getFrameBuffer()
 {
-	return &frameBuffer;
+	return frameBuffer.get();
 }
 
 GLint Media::getTextureID()
 {
-	return getFrameBuffer()->getTextureID();
+	if (GLuint texID = handoff.getTextureID()) return texID;
+	return frameBuffer.getTextureID();
 }
 
 void Media::registerTarget(MediaTarget* target)
 {
 	usedTargets.addIfNotAlreadyThere(target);
+	if (GlContextHolder::getInstanceWithoutCreating() != nullptr) GlContextHolder::getInstance()->renderGraph.setDirty();
 }
 
 void Media::unregisterTarget(MediaTarget* target)
 {
 	usedTargets.removeAllInstancesOf(target);
+	if (GlContextHolder::getInstanceWithoutCreating() != nullptr) GlContextHolder::getInstance()->renderGraph.setDirty();
+}
+
+void Media::getRenderConsumers(Array<OpenGLRenderer*>& consumers)
+{
+	ScopedLock lock(usedTargets.getLock());
+	for (auto& t : usedTargets)
+	{
+		if (!t->isUsingMedia(this)) continue;
+		if (OpenGLRenderer* r = t->getRenderConsumer()) consumers.addIfNotAlreadyThere(r);
+	}
 }
 
 //for sequence or other meta-media systems
@@ -135,16 +159,11 @@ void Media::handleExit()
 	setCustomTime(-1);
 }
 
-bool Media::isBeingUsed()
-{
-	if (usedTargets.size() == 0) return false;
-	for (auto& u : usedTargets) if (u->isUsingMedia(this)) return true;
-	return false;
-}
-
 void Media::openGLContextClosing()
 {
 	closeGLInternal();
+	renderTimer.release();
+	handoff.release();
 	frameBuffer.release();
 }
 
@@ -153,7 +172,7 @@ void Media::initFrameBuffer()
 	Point<int> size = getMediaSize();
 	if (size.isOrigin()) return;
 
-	frameBuffer.initialise(GlContextHolder::getInstance()->context, size.x, size.y);
+	frameBuffer.initialise(size.x, size.y);
 	shouldRedraw = true;
 }
 
@@ -166,33 +185,19 @@ Point<int> Media::getMediaSize()
 
 void Media::FPSTick()
 {
-	double currentTime = juce::Time::getMillisecondCounterHiRes();
-	double elapsedMillis = currentTime - lastFPSTick;
-	lastFPSTick = currentTime;
-	lastFPSIndex = (lastFPSIndex + 1) % 10;
-	lastFPSHistory[lastFPSIndex] = elapsedMillis;
-
-	double averageElapsed = 0;
-	for (int i = 0; i < 10; i++) {
-		averageElapsed += lastFPSHistory[i];
-	}
-	averageElapsed /= 10;
+	//called for each frame from the GL or decoder threads, the StatsPublisher turns it into currentFPS
+	frameTimes.push(Time::getMillisecondCounterHiRes());
+}
 
-	float fps = 1000.0 / averageElapsed;
+void Media::publishStats()
+{
+	if (isClearing) return;
 
-	int max = ceil(fps / 10.0) * 10;
+	float fps = frameTimes.getFPS(Time::getMillisecondCounterHiRes());
 
-	// Calcul des FPS
-	MessageManager::callAsync([this, max, fps]()
-		{
-			if(isClearing) return;
-			if (Engine::mainEngine->isClearing) return;
-
-			if ((float)currentFPS->maximumValue < max) {
-				currentFPS->maximumValue = max;
-			}
-			currentFPS->setValue(fps);
-		});
+	int max = ceil(fps / 10.0) * 10;
+	if ((float)currentFPS->maximumValue < max) currentFPS->maximumValue = max;
+	currentFPS->setValue(fps);
 }
 
 
@@ -217,13 +222,14 @@ void ImageMedia::renderGLInternal()
 
 	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, image.getWidth(), image.getHeight(), GL_BGRA, GL_UNSIGNED_BYTE, bitmapData->data);
 	glBindTexture(GL_TEXTURE_2D, 0);
+	renderTimer.addUpload((int64)image.getWidth() * image.getHeight() * 4);
 }
 
 void ImageMedia::initFrameBuffer()
 {
 	GenericScopedLock lock(imageLock);
-	if (frameBuffer.isValid()) frameBuffer.release();
-	frameBuffer.initialise(GlContextHolder::getInstance()->context, image);
+	//pixels are uploaded on next render
+	frameBuffer.initialise(image.getWidth(), image.getHeight());
 	shouldRedraw = true;
 }
 
@@ -14,7 +14,9 @@
 
 class Media :
 	public BaseItem,
-	public OpenGLRenderer
+	public OpenGLRenderer,
+	public RenderGraphNode,
+	public StatsPublisher::Source
 {
 public:
 	Media(const String& name = "Media", var params = var(), bool hasCustomSize = false);
@@ -25,22 +27,25 @@ public:
 
 	ControllableContainer mediaParams;
 
-	OpenGLFrameBuffer frameBuffer;
+	PooledFrameBuffer frameBuffer;
+	FrameHandoff handoff; //completed frames for the screens, when medias have their own thread
 	bool alwaysRedraw;
 	bool shouldRedraw;
+	std::atomic<int64> renderedFrames; //bumped each time the frame buffer gets new content, which may keep the same texture
 	bool flipY;
 
-	Array<MediaTarget*> usedTargets;
+	Array<MediaTarget*, CriticalSection> usedTargets;
 
-	double timeAtLastRender;
+	FrameScheduler::Slot renderSlot;
 	double customTime;
 
+	IntParameter* renderFPS;
 	FloatParameter* currentFPS;
-	double lastFPSTick;
-	double lastFPSHistory[10];
-	int lastFPSIndex;
+	RenderTimer renderTimer;
+	FrameTimeRing frameTimes;
 	bool customFPSTick;
 	void FPSTick();
+	void publishStats() override;
 
 	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
 
@@ -61,6 +66,9 @@ public:
 	void registerTarget(MediaTarget* target);
 	void unregisterTarget(MediaTarget* target);
 
+	void getRenderConsumers(Array<OpenGLRenderer*>& consumers) override;
+	String getRenderNodeName() const override { return niceName; }
+
 	//for sequence or other meta-media systems
 	void setCustomTime(double time, bool seekMode = false);
 	virtual void handleEnter(double time);
@@ -69,8 +77,6 @@ public:
 	virtual void handleStop() {}
 	virtual void handleStart() {}
 
-	bool isBeingUsed();
-
 	virtual Point<int> getMediaSize();
 };
 
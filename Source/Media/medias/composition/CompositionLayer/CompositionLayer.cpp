@@ -109,6 +109,10 @@ void CompositionLayer::onContainerParameterChangedInternal(Parameter* p)
 			unregisterUseMedia(COMPOSITION_TARGET_MEDIA_ID);
 		}
 	}
+	else if (p == enabled)
+	{
+		notifyMediaUsageChanged();
+	}
 	else if (p == blendFunction) {
 		blendPreset preset = blendFunction->getValueDataAsEnum<blendPreset>();
 		if (preset == CUSTOM) {
@@ -25,6 +25,7 @@ CompositionLayerManager::~CompositionLayerManager()
 
 void CompositionLayerManager::addItemInternal(CompositionLayer* o, var data)
 {
+    if (GlContextHolder::getInstanceWithoutCreating() != nullptr) GlContextHolder::getInstance()->renderGraph.setDirty();
 }
 
 void CompositionLayerManager::removeItemInternal(CompositionLayer* o)
@@ -36,11 +36,11 @@ void CompositionMedia::renderGLInternal()
     glClearColor(c.getFloatRed(), c.getFloatGreen(), c.getFloatBlue(), c.getFloatAlpha());
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glViewport(0, 0, frameBuffer.getWidth(), frameBuffer.getHeight());
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glOrtho(0, frameBuffer.getWidth(), frameBuffer.getHeight(), 0, 0, 1);
     glEnable(GL_BLEND);
 
+    QuadBatcher& batcher = GlContextHolder::getInstance()->getQuadBatcher();
+    batcher.begin(frameBuffer.getWidth(), frameBuffer.getHeight(), true);
+
     for (int i = 0; i < layers.items.size(); i++) {
         CompositionLayer* l = layers.items[i];
         Media* m = dynamic_cast<Media*>(l->media->targetContainer.get());
@@ -75,7 +75,7 @@ void CompositionMedia::renderGLInternal()
             case CompositionLayer::ONE_MINUS_DST_COLOR: dFactor = GL_ONE_MINUS_DST_COLOR; break;
             }
 
-            glBlendFunc(sFactor, dFactor);
+            batcher.setBlendFunc(sFactor, dFactor);
 
             int x = l->position->x;
             int y = l->position->y;
@@ -88,31 +88,18 @@ void CompositionMedia::renderGLInternal()
             // Niveau de transparence (0.0 pour complètement transparent, 1.0 pour complètement opaque)
             float alpha = l->alpha->floatValue();
 
-            // Active la texture
-            glBindTexture(GL_TEXTURE_2D, m->getTextureID());
-            // Applique la rotation et la transparence
-            glPushMatrix();
-            glTranslatef(x + width / 2.0f, y + height / 2.0f, 0.0f);
-            glRotatef(rotationAngle, 0.0f, 0.0f, 1.0f);
-            glTranslatef(-width / 2.0f, -height / 2.0f, 0.0f);
-
-            float yA = m->flipY ? y + height : y;
-            float yB = m->flipY ? y : y + height;
-
-            // Dessine le rectangle avec la texture
-            glColor4f(1.0f, 1.0f, 1.0f, alpha);
-            glBegin(GL_QUADS);
-            glTexCoord2f(0.0f, 0.0f); glVertex2f(x, yB);
-            glTexCoord2f(1.0f, 0.0f); glVertex2f(x + width, yB);
-            glTexCoord2f(1.0f, 1.0f); glVertex2f(x + width, yA);
-            glTexCoord2f(0.0f, 1.0f); glVertex2f(x, yA);
-            glEnd();
-            glBindTexture(GL_TEXTURE_2D, 0);
-            juce::gl::glPopMatrix();
-        }
+            // Same placement as the old matrix stack : translate(x + w/2, y + h/2), rotate, translate(-w/2, -h/2),
+            // applied to a quad already at (x, y), so the layer ends up at twice its position, rotated around its own size
+            AffineTransform transform = AffineTransform::translation(-width / 2.0f, -height / 2.0f)
+                .rotated(degreesToRadians(rotationAngle))
+                .translated(x + width / 2.0f, y + height / 2.0f);
 
-        // Restaure la matrice de modèle-vue
+            // Les textures GL ont l'origine en bas, la projection est de haut en bas
+            batcher.drawTexture(m->getTextureID(), Rectangle<float>(x, y, width, height), Colours::white.withAlpha(alpha), !m->flipY, Rectangle<float>(0, 0, 1, 1), transform);
+        }
     }
+
+    batcher.end();
     //frameBuffer.releaseAsRenderingTarget();
 
 }
@@ -78,6 +78,8 @@ void MediaClip::onContainerParameterChangedInternal(Parameter* p)
 
 	if (p == isActive || p == enabled)
 	{
+		notifyMediaUsageChanged();
+
 		bool active = isActive->boolValue() && enabled->boolValue();
 
 		if (media != nullptr)
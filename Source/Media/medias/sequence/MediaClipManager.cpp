@@ -30,6 +30,7 @@ void MediaClipManager::addItemInternal(LayerBlock* block, var data)
 	LayerBlockManager::addItemInternal(block, data);
 	MediaClip* clip = dynamic_cast<MediaClip*>(block);
 	clip->addMediaClipListener(this);
+	if (GlContextHolder::getInstanceWithoutCreating() != nullptr) GlContextHolder::getInstance()->renderGraph.setDirty();
 }
 
 void MediaClipManager::addItemsInternal(Array<LayerBlock*> blocks, var data)
@@ -40,6 +41,7 @@ void MediaClipManager::addItemsInternal(Array<LayerBlock*> blocks, var data)
 		MediaClip* clip = dynamic_cast<MediaClip*>(b);
 		clip->addMediaClipListener(this);
 	}
+	if (GlContextHolder::getInstanceWithoutCreating() != nullptr) GlContextHolder::getInstance()->renderGraph.setDirty();
 }
 
 void MediaClipManager::removeItemInternal(LayerBlock* block)
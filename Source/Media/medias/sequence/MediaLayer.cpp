@@ -30,8 +30,7 @@ MediaLayer::~MediaLayer()
 
 void MediaLayer::initFrameBuffer(int width, int height)
 {
-	if (frameBuffer.isValid()) frameBuffer.release();
-	frameBuffer.initialise(GlContextHolder::getInstance()->context, width, height);
+	frameBuffer.initialise(width, height);
 }
 
 bool MediaLayer::renderFrameBuffer(int width, int height)
@@ -66,37 +65,24 @@ bool MediaLayer::renderFrameBuffer(int width, int height)
 
 	glEnable(GL_BLEND);
 
-	int index = 0;
+	QuadBatcher& batcher = GlContextHolder::getInstance()->getQuadBatcher();
+	batcher.begin(width, height);
+	batcher.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
 	for (auto& clip : clipsToProcess)
 	{
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-		glBindTexture(GL_TEXTURE_2D, clip->media->frameBuffer.getTextureID());
+		GLuint texID = clip->media->getTextureID();
+		glBindTexture(GL_TEXTURE_2D, texID);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-
-
 		//draw full quad
-
 		double fadeMultiplier = clip->getFadeMultiplier();
-
-		glColor4f(1, 1, 1, fadeMultiplier);
-
-		if (clip->media->flipY)
-		{
-			Draw2DTexRectFlipped(0, 0, width, height);
-		}
-		else
-		{
-			Draw2DTexRect(0, 0, width, height);
-		}
-
-		glBindTexture(GL_TEXTURE_2D, 0);
-
-		index++;
+		batcher.drawTexture(texID, Rectangle<float>(0, 0, width, height), Colours::white.withAlpha((float)fadeMultiplier), clip->media->flipY);
 	}
 
+	batcher.end();
+
 	frameBuffer.releaseAsRenderingTarget();
 
 	return true;
@@ -105,31 +91,33 @@ bool MediaLayer::renderFrameBuffer(int width, int height)
 void MediaLayer::renderGL(int depth)
 {
 
+	QuadBatcher& batcher = GlContextHolder::getInstance()->getQuadBatcher();
+	batcher.begin(frameBuffer.getWidth(), frameBuffer.getHeight());
+
 	BlendMode bm = blendMode->getValueDataAsEnum<BlendMode>();
 
 	switch (bm)
 	{
 	case Alpha:
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		batcher.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 		break;
 
 	case Add:
-		glBlendFunc(GL_ONE, GL_ONE);
+		batcher.setBlendFunc(GL_ONE, GL_ONE);
 		break;
 
 	case Multiply:
-		glBlendFunc(GL_DST_COLOR, GL_ZERO);
+		batcher.setBlendFunc(GL_DST_COLOR, GL_ZERO);
 		break;
 	}
 
-	glBindTexture(GL_TEXTURE_2D, frameBuffer.getTextureID());
+	GLuint texID = frameBuffer.getTextureID();
+	glBindTexture(GL_TEXTURE_2D, texID);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-	glColor4f(1, 1, 1, 1);
-	Draw2DTexRectDepth(0, 0, frameBuffer.getWidth(), frameBuffer.getHeight(), depth);
-	glBindTexture(GL_TEXTURE_2D, 0);
-
+	batcher.drawTexture(texID, Rectangle<float>(0, 0, frameBuffer.getWidth(), frameBuffer.getHeight()));
+	batcher.end();
 }
 
 void MediaLayer::sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool evaluateSkippedData)
@@ -24,7 +24,7 @@ public:
 	enum BlendMode { Alpha, Add, Multiply };
 	EnumParameter* blendMode;
 
-	OpenGLFrameBuffer frameBuffer;
+	PooledFrameBuffer frameBuffer;
 
 	void initFrameBuffer(int width, int height);
 	bool renderFrameBuffer(int width, int height);
@@ -219,7 +219,7 @@ void ShaderMedia::loadFragmentShader(const String& fragmentShader)
 	bool fragmentIsShaderToy = fragmentShader.contains("mainImage");
 	if (isShaderToy != fragmentIsShaderToy) shaderType->setValueWithData(fragmentIsShaderToy ? ShaderToyFile : ShaderGLSLFile);
 
-	shader.reset(new OpenGLShaderProgram(GlContextHolder::getInstance()->context));
+	shader.reset(new OpenGLShaderProgram(GlContextHolder::getInstance()->getCurrentContext()));
 
 	String fShader = fragmentShader.contains("#version") ? "" : "#version 330\n";
 	st = shaderType->getValueDataAsEnum<ShaderType>();
@@ -52,16 +52,18 @@ void SharedTextureMedia::renderGLInternal()
 	if (receiver == nullptr || receiver->width == 0 || receiver->height == 0) return;
 
 
-	glBindTexture(GL_TEXTURE_2D, receiver->fbo->getTextureID());
+	GLuint texID = receiver->fbo->getTextureID();
+	glBindTexture(GL_TEXTURE_2D, texID);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
 	//draw full quad
 	Init2DViewport(receiver->width, receiver->height);
-	glColor3f(1, 1, 1);
-	Draw2DTexRect(0, 0, receiver->width, receiver->height);
 
-	glBindTexture(GL_TEXTURE_2D, 0);
+	QuadBatcher& batcher = GlContextHolder::getInstance()->getQuadBatcher();
+	batcher.begin(receiver->width, receiver->height);
+	batcher.drawTexture(texID, Rectangle<float>(0, 0, receiver->width, receiver->height));
+	batcher.end();
 }
 
 Point<int> SharedTextureMedia::getMediaSize()
@@ -80,6 +80,7 @@ void WebcamMedia::renderGLInternal()
 	glBindTexture(GL_TEXTURE_2D, frameBuffer.getTextureID());
 	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, bitmapData->width, bitmapData->height, GL_BGR, GL_UNSIGNED_BYTE, bitmapData->data);
 	glBindTexture(GL_TEXTURE_2D, 0);
+	renderTimer.addUpload((int64)bitmapData->width * bitmapData->height * 3);
 }
 
 void WebcamMedia::WebcamImageReceived(const Image& camImage) {
@@ -14,6 +14,8 @@ Screen::Screen(var params) :
 	BaseItem(params.getProperty("name", "Screen")),
 	objectType(params.getProperty("type", "Screen").toString()),
 	objectData(params),
+	spatialIndex(this),
+	recorder(this),
 	sharedTextureSender(nullptr)
 {
 	saveAndLoadRecursiveData = true;
@@ -27,14 +29,24 @@ Screen::Screen(var params) :
 	outputType->addOption("Display", DISPLAY)->addOption("Shared Texture", SHARED_TEXTURE)->addOption("NDI", NDI);
 
 	screenID = addIntParameter("Screen number", "Screen ID in your OS", 1, 0);
+	syncToDisplay = addBoolParameter("Sync to display", "Present the output window on the vertical sync of its display. Disable to present at 60 fps without waiting for the display, which may tear", true);
+	maxFramesInFlight = addIntParameter("Max frames in flight", "Number of frames the output window may queue on the GPU before waiting for the oldest one. 1 gives the lowest latency, more absorbs irregular frame times", 1, 1, ScreenOutput::maxFenceCount);
+	frameLock = addBoolParameter("Frame lock", "Present the same rendered frame at the same time as the other frame locked display outputs, so content moving across projector seams doesn't tear. Outputs on displays with different refresh rates follow the slowest one", true);
 
 	showTestPattern = addBoolParameter("Show Test Pattern", "Show a test pattern on the screen", false);
 
 	snapDistance = addFloatParameter("Snap distance", "Distance in pixels to snap to another point", .05f, 0, .2f);
+	batchSurfaces = addBoolParameter("Batch surfaces", "Draw all the surfaces in as few draw calls as possible. Disable to get the render stats of each surface", true);
+	bakeWarpMap = addBoolParameter("Bake warp map", "Bake the geometry of all the surfaces in a texture when it changes and draw the screen in one pass per media. Keeps dense warps cheap on small machines, overlapping surfaces are not blended", false);
+	autoBlend = addBoolParameter("Auto blend", "Blend the surfaces showing overlapping parts of the same media, as set by their crop, like projectors with an overlap. The ramps are computed when the crops change and added to the precomputed mask of each surface", false);
+	blendGamma = addFloatParameter("Blend gamma", "Gamma of the projectors, the blend ramps are corrected so the overlaps keep the same brightness", 2.2f, 1, 4);
 
 	if (!Engine::mainEngine->isLoadingFile) surfaces.addItem();
 
 	addChildControllableContainer(&surfaces);
+	addChildControllableContainer(&renderTimer);
+	addChildControllableContainer(&presentTimer);
+	addChildControllableContainer(&recorder);
 
 	renderer.reset(new ScreenRenderer(this));
 }
@@ -47,10 +59,18 @@ Screen::~Screen()
 void Screen::clearItem()
 {
 	BaseItem::clearItem();
+
+	recorder.stopRecording();
 	
 	if(SharedTextureManager::getInstanceWithoutCreating() != nullptr) SharedTextureManager::getInstance()->removeSender(sharedTextureSender);
 	sharedTextureSender = nullptr;
 
+	std::shared_ptr<NDIOutput> oldOutput;
+	{
+		GenericScopedLock lock(ndiOutputLock);
+		oldOutput.swap(ndiOutput);
+	}
+
 	//enabled->setValue(false);
 }
 
@@ -60,6 +80,11 @@ void Screen::onContainerParameterChangedInternal(Parameter* p)
 	{
 		setupOutput();
 	}
+	else if (p == autoBlend)
+	{
+		//switches the surfaces to their precomputed alpha
+		for (auto& s : surfaces.items) s->paramsVersion++;
+	}
 
 	if (sharedTextureSender != nullptr)
 	{
@@ -72,6 +97,31 @@ void Screen::onContainerNiceNameChanged()
 {
 	BaseItem::onContainerNiceNameChanged();
 	if (sharedTextureSender != nullptr) sharedTextureSender->setSharingName(niceName);
+
+	//NDI sources can't be renamed
+	if (ndiOutput != nullptr) setupOutput();
+}
+
+void Screen::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
+{
+	BaseItem::onControllableFeedbackUpdateInternal(cc, c);
+
+	if (Point2DParameter* p = dynamic_cast<Point2DParameter*>(c))
+	{
+		spatialIndex.handleMoved(p);
+		return;
+	}
+
+	//surfaces entering or leaving the picking
+	Surface* s = dynamic_cast<Surface*>(cc);
+	if (s == nullptr && cc != nullptr) s = dynamic_cast<Surface*>(cc->parentContainer.get());
+	if (s != nullptr && (c == s->enabled || c == s->isUILocked || c == s->bezierCC.enabled)) spatialIndex.setDirty();
+}
+
+void Screen::childStructureChanged(ControllableContainer* cc)
+{
+	BaseItem::childStructureChanged(cc);
+	spatialIndex.setDirty();
 }
 
 void Screen::setupOutput()
@@ -79,6 +129,16 @@ void Screen::setupOutput()
 	SharedTextureManager::getInstance()->removeSender(sharedTextureSender);
 	sharedTextureSender = nullptr;
 
+	std::shared_ptr<NDIOutput> newOutput;
+	if (outputType->getValueDataAsEnum<OutputType>() == NDI) newOutput.reset(new NDIOutput(niceName));
+
+	//the old one stops its thread here, or on the GL thread if it is still sending
+	{
+		GenericScopedLock lock(ndiOutputLock);
+		ndiOutput.swap(newOutput);
+	}
+	newOutput.reset();
+
 	OutputType type = outputType->getValueDataAsEnum<OutputType>();
 	switch (type)
 	{
@@ -87,7 +147,7 @@ void Screen::setupOutput()
 
 	case SHARED_TEXTURE:
 		sharedTextureSender = SharedTextureManager::getInstance()->addSender(niceName, screenWidth->intValue(), screenHeight->intValue());
-		sharedTextureSender->setExternalFBO(&renderer->frameBuffer);
+		if (renderer->frameBuffer.isValid()) sharedTextureSender->setExternalFBO(renderer->frameBuffer.get());
 		break;
 
 	case NDI:
@@ -95,40 +155,15 @@ void Screen::setupOutput()
 	}
 }
 
-Point2DParameter* Screen::getClosestHandle(Point<float> pos, float maxDistance, Array<Point2DParameter*> excludeHandles)
+std::shared_ptr<NDIOutput> Screen::getNDIOutput()
 {
-	Point2DParameter* result = nullptr;
+	GenericScopedLock lock(ndiOutputLock);
+	return ndiOutput;
+}
 
-	float closestDist = maxDistance;
-	for (auto& s : surfaces.items)
-	{
-		if (!s->enabled->boolValue() || s->isUILocked->boolValue()) continue;
-
-		Array<Point2DParameter*> handles = { s->topLeft, s->topRight, s->bottomLeft, s->bottomRight };
-
-
-		if (s->bezierCC.enabled->boolValue()) {
-			Array<Point2DParameter*> bezierHandles = { s->handleBezierTopLeft, s->handleBezierTopRight, s->handleBezierBottomLeft, s->handleBezierBottomRight, s->handleBezierLeftTop, s->handleBezierLeftBottom, s->handleBezierRightTop, s->handleBezierRightBottom };
-			handles.addArray(bezierHandles);
-		}
-
-		for (int i = 0; i < s->pinsCC.items.size(); i++) {
-			handles.add(s->pinsCC.items[i]->position);
-		}
-
-		for (auto& h : handles)
-		{
-			if (excludeHandles.contains(h)) continue;
-			float dist = h->getPoint().getDistanceFrom(pos);
-			if (maxDistance > 0 && dist > maxDistance) continue;
-			if (dist < closestDist)
-			{
-				result = h;
-				closestDist = dist;
-			}
-		}
-	}
-	return result;
+Point2DParameter* Screen::getClosestHandle(Point<float> pos, float maxDistance, Array<Point2DParameter*> excludeHandles)
+{
+	return spatialIndex.getClosestHandle(pos, maxDistance, excludeHandles);
 }
 
 Point2DParameter* Screen::getSnapHandle(Point<float> pos, Point2DParameter* handle)
@@ -138,27 +173,10 @@ Point2DParameter* Screen::getSnapHandle(Point<float> pos, Point2DParameter* hand
 
 Array<Point2DParameter*> Screen::getOverlapHandles(Point2DParameter* handle)
 {
-	Array<Point2DParameter*> result;
-	for (auto& s : surfaces.items)
-	{
-		if (!s->enabled->boolValue() || s->isUILocked->boolValue()) continue;
-		Array<Point2DParameter*> handles = { s->topLeft, s->topRight, s->bottomLeft, s->bottomRight };
-		for (auto& h : handles)
-		{
-			if (h == handle) continue;
-			if (h->getPoint() == handle->getPoint())
-				result.add(h);
-		}
-	}
-	return result;
+	return spatialIndex.getOverlapHandles(handle);
 }
 
 Surface* Screen::getSurfaceAt(Point<float> pos)
 {
-	for (auto& s : surfaces.items)
-	{
-		if (!s->enabled->boolValue()) continue;
-		if (s->isPointInside(pos)) return s;
-	}
-	return nullptr;
+	return spatialIndex.getSurfaceAt(pos);
 }
@@ -28,19 +28,37 @@ public:
     enum OutputType { DISPLAY, SHARED_TEXTURE, NDI };
     EnumParameter* outputType;
     IntParameter* screenID;
+    BoolParameter* syncToDisplay;
+    IntParameter* maxFramesInFlight;
+    BoolParameter* frameLock;
 
     BoolParameter* showTestPattern;
     FloatParameter* snapDistance;
+    BoolParameter* batchSurfaces;
+    BoolParameter* bakeWarpMap;
+    BoolParameter* autoBlend;
+    FloatParameter* blendGamma;
 
     SurfaceManager surfaces;
+    RenderTimer renderTimer;
+    PresentTimer presentTimer;
+    ScreenSpatialIndex spatialIndex;
+    ScreenRecorder recorder;
 
     std::unique_ptr<ScreenRenderer> renderer;
     SharedTextureSender* sharedTextureSender;
 
+    //created on the message thread, used by the renderer on the GL thread
+    std::shared_ptr<NDIOutput> ndiOutput;
+    SpinLock ndiOutputLock;
+    std::shared_ptr<NDIOutput> getNDIOutput();
+
     void clearItem() override;
 
     void onContainerParameterChangedInternal(Parameter* p) override;
     void onContainerNiceNameChanged() override;
+    void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
+    void childStructureChanged(ControllableContainer* cc) override;
 
     void setupOutput();
     
@@ -13,13 +13,22 @@
 
 #include "Screen.cpp"
 #include "ScreenManager.cpp"
+#include "ScreenSpatialIndex.cpp"
+#include "ScreenRecorder.cpp"
 #include "ui/ScreenRenderer.cpp"
+#include "ui/SurfaceBatch.cpp"
+#include "ui/WarpMap.cpp"
+#include "ui/SurfaceAlphaBaker.cpp"
+#include "ui/ScreenNDISender.cpp"
 #include "ui/ScreenManagerUI.cpp"
+#include "ui/PresentBarrier.cpp"
 #include "ui/ScreenOutput.cpp"
 
 #include "Surface/Pin.cpp"
+#include "Surface/DelaunayTriangulation.cpp"
 
 #include "Surface/Surface.cpp"
+#include "Surface/SurfaceMeshBuilder.cpp"
 #include "Surface/SurfaceManager.cpp"
 #include "Surface/ui/SurfaceUI.cpp"
 
@@ -13,14 +13,24 @@
 #include "JuceHeader.h"
 
 #include "Surface/Pin.h"
+#include "Surface/DelaunayTriangulation.h"
 
 #include "Surface/Surface.h"
+#include "Surface/SurfaceMeshBuilder.h"
 #include "Surface/SurfaceManager.h"
 
+#include "ScreenSpatialIndex.h"
+#include "ScreenRecorder.h"
+
 #include "Screen.h"
 #include "ScreenManager.h"
 
+#include "ui/PresentBarrier.h"
 #include "ui/ScreenOutput.h"
+#include "ui/SurfaceBatch.h"
+#include "ui/WarpMap.h"
+#include "ui/SurfaceAlphaBaker.h"
+#include "ui/ScreenNDISender.h"
 #include "ui/ScreenRenderer.h"
 #include "ui/ScreenManagerUI.h"
 #include "Surface/ui/SurfaceUI.h"
@@ -0,0 +1,471 @@
+/*
+  ==============================================================================
+
+	ScreenRecorder.cpp
+	Created: 18 Oct 2026 9:03:27pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Screen/ScreenIncludes.h"
+#include "Common/CommonIncludes.h"
+#include "Media/MediaIncludes.h"
+
+OwnedArray<ScreenRecorder::Writer> ScreenRecorder::writers;
+CriticalSection ScreenRecorder::writersLock;
+
+ScreenRecorder::ScreenRecorder(Screen* screen) :
+	ControllableContainer("Recorder"),
+	screen(screen),
+	offlineFrame(0),
+	numOfflineFrames(0),
+	pendingFrame(-1),
+	mainTickAtStep(0),
+	productionTickAtStep(0)
+{
+	record = addBoolParameter("Record", "Record the screen to the output file. In offline mode, stops by itself once the duration is recorded", false);
+	record->isSavable = false;
+
+	mode = addEnumParameter("Mode", "Realtime records the screen as it plays, repeating the previous frame when a frame can't be captured in time. Offline steps the time of the medias and sequences frame by frame, never drops any and renders as fast as the GPU allows");
+	mode->addOption("Realtime", REALTIME)->addOption("Offline", OFFLINE);
+
+	outputFile = addFileParameter("Output file", "Video file to write, its extension picks the container", "");
+	outputFile->saveMode = true;
+
+	fps = addIntParameter("FPS", "Frame rate of the recording", 30, 1, 240);
+	startTime = addFloatParameter("Start time", "Offline only, time of the medias and sequences at the first frame, in seconds", 0, 0);
+	duration = addFloatParameter("Duration", "Offline only, length of the recording in seconds", 10, 0);
+	ffmpegPath = addStringParameter("FFmpeg", "Path of the ffmpeg executable, or just ffmpeg if it can be found in the PATH", "ffmpeg");
+	encoderOptions = addStringParameter("Encoder options", "FFmpeg output options, before the file", "-c:v libx264 -preset fast -crf 18 -pix_fmt yuv420p");
+	maxQueuedFrames = addIntParameter("Max queued frames", "Number of frames waiting for the encoder before the previous frame is repeated instead of capturing new ones, or offline, before the time stops stepping", 8, 1, 120);
+
+	recordedFrames = addIntParameter("Recorded frames", "Number of frames written to the encoder since the recording started", 0, 0);
+	droppedFrames = addIntParameter("Dropped frames", "Number of frames that could not be captured since the recording started, the previous frame is written in their place", 0, 0);
+	recordedFrames->isSavable = false;
+	recordedFrames->enabled = false;
+	droppedFrames->isSavable = false;
+	droppedFrames->enabled = false;
+
+	StatsPublisher::getInstance()->addSource(this);
+}
+
+ScreenRecorder::~ScreenRecorder()
+{
+	stopRecording();
+	if (StatsPublisher::getInstanceWithoutCreating() != nullptr) StatsPublisher::getInstance()->removeSource(this);
+}
+
+void ScreenRecorder::onContainerParameterChangedInternal(Parameter* p)
+{
+	if (p == record)
+	{
+		if (record->boolValue()) startRecording();
+		else stopRecording();
+	}
+}
+
+std::shared_ptr<ScreenRecorder::Session> ScreenRecorder::getSession()
+{
+	GenericScopedLock lock(sessionLock);
+	return session;
+}
+
+String ScreenRecorder::getCommand(const Session& s) const
+{
+	//readbacks come bottom row first
+	String command = ffmpegPath->stringValue().quoted() + " -y -loglevel error -f rawvideo -pix_fmt rgba"
+		+ " -s " + String(s.frameSize.x) + "x" + String(s.frameSize.y)
+		+ " -r " + String(s.fps)
+		+ " -i - -vf vflip " + encoderOptions->stringValue()
+		+ " " + outputFile->getFile().getFullPathName().quoted();
+
+#if JUCE_WINDOWS
+	//_popen runs cmd /c, which strips the first and last quotes of the command
+	command = command.quoted();
+#endif
+
+	return command;
+}
+
+void ScreenRecorder::startRecording()
+{
+	if (getSession() != nullptr) return;
+
+	if (outputFile->stringValue().isEmpty())
+	{
+		NLOGERROR(screen->niceName, "Recorder : no output file");
+		record->setValue(false);
+		return;
+	}
+
+	std::shared_ptr<Session> s = std::make_shared<Session>();
+	s->name = screen->niceName;
+	s->frameSize = Point<int>(screen->screenWidth->intValue(), screen->screenHeight->intValue());
+	s->fps = fps->intValue();
+	s->queueLimit = maxQueuedFrames->intValue();
+	s->isOffline = mode->getValueDataAsEnum<Mode>() == OFFLINE;
+
+	const String command = getCommand(*s);
+
+#if JUCE_WINDOWS
+	s->pipe = _popen(command.toRawUTF8(), "wb");
+#else
+	s->pipe = popen(command.toRawUTF8(), "w");
+#endif
+
+	if (s->pipe == nullptr)
+	{
+		NLOGERROR(screen->niceName, "Recorder : could not start " << command);
+		record->setValue(false);
+		return;
+	}
+
+	bool writerStarted = false;
+	{
+		GenericScopedLock lock(writersLock);
+
+		//the previous recordings are done with them
+		for (int i = writers.size() - 1; i >= 0; i--)
+		{
+			if (!writers[i]->isThreadRunning()) writers.remove(i);
+		}
+
+		Writer* w = writers.add(new Writer(s));
+		writerStarted = w->startThread();
+		if (!writerStarted) writers.removeObject(w);
+	}
+
+	if (!writerStarted)
+	{
+#if JUCE_WINDOWS
+		_pclose(s->pipe);
+#else
+		pclose(s->pipe);
+#endif
+		NLOGERROR(screen->niceName, "Recorder : could not start the writer thread");
+		record->setValue(false);
+		return;
+	}
+
+	//the GL thread only touches these once the session is set
+	pendingFrame = -1;
+	statsSession = s;
+
+	{
+		GenericScopedLock lock(sessionLock);
+		session = s;
+	}
+
+	NLOG(screen->niceName, "Recorder : recording to " << outputFile->getFile().getFullPathName());
+
+	if (s->isOffline)
+	{
+		GlContextHolder::getInstance()->offlineRenderers++;
+
+		for (auto& m : MediaManager::getInstance()->items)
+		{
+			if (SequenceMedia* sm = dynamic_cast<SequenceMedia*>(m))
+			{
+				if (sm->sequence.isPlaying->boolValue()) sm->sequence.pauseTrigger->trigger();
+			}
+		}
+
+		offlineFrame = 0;
+		numOfflineFrames = jmax(1, roundToInt(duration->floatValue() * s->fps));
+
+		//steps right after each capture, polls while the queue is full
+		startTimer(5);
+		stepOffline();
+	}
+}
+
+void ScreenRecorder::stopRecording()
+{
+	std::shared_ptr<Session> s;
+	{
+		GenericScopedLock lock(sessionLock);
+		s.swap(session);
+	}
+
+	if (s == nullptr) return;
+
+	stopTimer();
+	cancelPendingUpdate();
+
+	//the writer finishes on its own, readbacks already requested included
+	s->isStopping = true;
+	s->frameQueued.signal();
+
+	if (s->isOffline)
+	{
+		GlContextHolder::getInstance()->offlineRenderers--;
+		setTime(-1);
+	}
+
+	pendingFrame = -1;
+	if (record->boolValue()) record->setValue(false);
+}
+
+void ScreenRecorder::frameRendered(PooledFrameBuffer& frameBuffer, int64 mainTick, int64 productionTick)
+{
+	std::shared_ptr<Session> s = getSession();
+	if (s == nullptr || s->isStopping) return;
+	if (frameBuffer.getWidth() != s->frameSize.x || frameBuffer.getHeight() != s->frameSize.y) return;
+
+	if (s->isOffline)
+	{
+		if (pendingFrame < 0) return;
+
+		//drawn in a main tick after the step. With a production thread, the medias it used have to come from
+		//a production tick that started after the step and was complete when this screen started drawing
+		if (mainTick <= mainTickAtStep) return;
+		if (productionTick >= 0 && productionTick < productionTickAtStep + 2) return;
+
+		if (!captureFrame(s, frameBuffer.getTextureID())) return; //readbacks are full, next frame
+
+		pendingFrame = -1;
+		triggerAsyncUpdate();
+		return;
+	}
+
+	//not capped by the render loop, the slots that went by since the last render are repeats of the previous frame
+	const double now = Time::getMillisecondCounterHiRes();
+	if (s->numSlots == 0) s->startTime = now;
+	const int64 dueSlots = (int64)((now - s->startTime) * s->fps / 1000.0) + 1;
+	if (dueSlots <= s->numSlots) return;
+
+	for (; s->numSlots < dueSlots - 1; s->numSlots++)
+	{
+		s->addFrame(false);
+		s->numDropped++;
+	}
+	s->numSlots++;
+
+	if (s->getNumQueued() >= s->queueLimit || !captureFrame(s, frameBuffer.getTextureID()))
+	{
+		s->addFrame(false);
+		s->numDropped++;
+	}
+}
+
+bool ScreenRecorder::captureFrame(std::shared_ptr<Session> s, GLuint texture)
+{
+	//queued before the request, the callback may come back before it returns
+	Session::Frame* f = s->addFrame(true);
+	bool queued = GlContextHolder::getInstance()->readback.request(texture, Rectangle<int>(0, 0, s->frameSize.x, s->frameSize.y), GPUReadback::RGBA,
+		[s, f](const GPUReadback::Result& r)
+		{
+			s->frameReadBack(f, r.data, r.lineStride);
+		});
+
+	if (!queued) s->removeFrame(f);
+	return queued;
+}
+
+void ScreenRecorder::handleAsyncUpdate()
+{
+	stepOffline();
+}
+
+void ScreenRecorder::timerCallback()
+{
+	stepOffline();
+}
+
+void ScreenRecorder::stepOffline()
+{
+	std::shared_ptr<Session> s = getSession();
+	if (s == nullptr || !s->isOffline || pendingFrame >= 0) return;
+
+	//the last capture is in, the writer gets the rest on its own
+	if (offlineFrame >= numOfflineFrames)
+	{
+		record->setValue(false);
+		return;
+	}
+
+	if (s->getNumQueued() >= s->queueLimit) return;
+
+	setTime(startTime->floatValue() + offlineFrame / (double)s->fps);
+
+	GlContextHolder* holder = GlContextHolder::getInstance();
+	mainTickAtStep = holder->frameScheduler.numTicks.load();
+	productionTickAtStep = holder->hasProductionThread() ? holder->production->frameScheduler.numTicks.load() : 0;
+	pendingFrame = offlineFrame++;
+}
+
+void ScreenRecorder::setTime(double time)
+{
+	//sequences last, their clips set the time of the medias they play
+	for (auto& m : MediaManager::getInstance()->items)
+	{
+		if (dynamic_cast<SequenceMedia*>(m) == nullptr) m->setCustomTime(time);
+	}
+
+	if (time < 0) return;
+
+	for (auto& m : MediaManager::getInstance()->items)
+	{
+		if (SequenceMedia* sm = dynamic_cast<SequenceMedia*>(m)) sm->sequence.setCurrentTime(time, true, false);
+	}
+}
+
+void ScreenRecorder::publishStats()
+{
+	if (statsSession == nullptr) return;
+	recordedFrames->setValue(statsSession->numRecorded.load());
+	droppedFrames->setValue(statsSession->numDropped.load());
+}
+
+ScreenRecorder::Writer::Writer(std::shared_ptr<Session> session) :
+	Thread("Recorder writer : " + session->name),
+	session(session)
+{
+}
+
+void ScreenRecorder::Writer::run()
+{
+	session->write();
+}
+
+void ScreenRecorder::joinWriters(int timeoutMs)
+{
+	GenericScopedLock lock(writersLock);
+
+	const uint32 endTime = Time::getMillisecondCounter() + (uint32)timeoutMs;
+	for (auto& w : writers)
+	{
+		const int remaining = jmax(0, (int)(endTime - Time::getMillisecondCounter()));
+		if (!w->waitForThreadToExit(remaining)) w->stopThread(1000);
+	}
+
+	writers.clear();
+}
+
+int ScreenRecorder::Session::getNumQueued()
+{
+	//repeats hold no memory
+	GenericScopedLock lock(queueLock);
+	int n = 0;
+	for (auto& f : queue) if (!f->isReady || f->data != nullptr) n++;
+	return n;
+}
+
+ScreenRecorder::Session::Frame* ScreenRecorder::Session::addFrame(bool isCapture)
+{
+	Frame* f = new Frame();
+	f->isReady = !isCapture;
+
+	{
+		GenericScopedLock lock(queueLock);
+		queue.add(f);
+	}
+
+	if (!isCapture) frameQueued.signal();
+	return f;
+}
+
+void ScreenRecorder::Session::removeFrame(Frame* f)
+{
+	//not ready, the writer never took it
+	GenericScopedLock lock(queueLock);
+	queue.removeObject(f);
+}
+
+void ScreenRecorder::Session::frameReadBack(Frame* f, const void* data, int lineStride)
+{
+	std::unique_ptr<MemoryBlock> block;
+
+	if (data != nullptr)
+	{
+		const size_t size = (size_t)lineStride * frameSize.y;
+
+		{
+			GenericScopedLock lock(queueLock);
+			if (!freeBlocks.isEmpty()) block.reset(freeBlocks.removeAndReturn(freeBlocks.size() - 1));
+		}
+
+		if (block == nullptr) block.reset(new MemoryBlock());
+		if (block->getSize() != size) block->setSize(size);
+		block->copyFrom(data, 0, size);
+	}
+	else
+	{
+		numDropped++;
+	}
+
+	{
+		GenericScopedLock lock(queueLock);
+		f->data = std::move(block);
+		f->isReady = true;
+	}
+
+	frameQueued.signal();
+}
+
+void ScreenRecorder::Session::write()
+{
+	bool writeFailed = false;
+	std::unique_ptr<MemoryBlock> previous; //written again for the repeats
+
+	//stopped when the app gives up waiting for the encoder
+	while (!Thread::currentThreadShouldExit())
+	{
+		//captures being read back stay in the queue until they are ready, in their place
+		std::unique_ptr<Frame> f;
+		bool isDone = false;
+		{
+			GenericScopedLock lock(queueLock);
+			if (!queue.isEmpty() && queue[0]->isReady) f.reset(queue.removeAndReturn(0));
+			isDone = isStopping && queue.isEmpty();
+		}
+
+		if (f == nullptr)
+		{
+			if (isDone) break;
+			frameQueued.wait(50);
+			continue;
+		}
+
+		const bool isRepeat = f->data == nullptr;
+		if (!isRepeat)
+		{
+			if (previous != nullptr)
+			{
+				GenericScopedLock lock(queueLock);
+				freeBlocks.add(previous.release());
+			}
+			previous = std::move(f->data);
+		}
+		else if (previous == nullptr)
+		{
+			//nothing captured yet, black
+			previous.reset(new MemoryBlock((size_t)frameSize.x * 4 * frameSize.y, true));
+		}
+
+		if (!writeFailed && fwrite(previous->getData(), 1, previous->getSize(), pipe) != previous->getSize())
+		{
+			writeFailed = true;
+			NLOGERROR(name, "Recorder : the encoder stopped, check the FFmpeg path and options");
+		}
+
+		if (!writeFailed) numRecorded++;
+		else if (!isRepeat) numDropped++; //repeats were counted when missed
+	}
+
+	//waits for the encoder to finish the file
+#if JUCE_WINDOWS
+	_pclose(pipe);
+#else
+	pclose(pipe);
+#endif
+	pipe = nullptr;
+
+	{
+		GenericScopedLock lock(queueLock);
+		freeBlocks.clear();
+	}
+
+	NLOG(name, "Recorder : " << numRecorded.load() << " frames recorded, " << numDropped.load() << " dropped");
+}
@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+	ScreenRecorder.h
+	Created: 18 Oct 2026 9:03:27pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class Screen;
+
+// Records the frames of a screen to a video file through an ffmpeg process fed raw RGBA on its standard input.
+// Frames are read back asynchronously by the GPUReadback and queued to a thread writing them to the pipe,
+// the queue is bounded so a slow encoder never makes memory grow.
+//
+// Realtime : frames are captured as they are rendered, at the recording rate counted from the wall clock. A frame that can't be
+// captured, because the queue is full or the screen renders slower than the recording, is replaced by the previous one.
+// Offline : the time of the medias and sequences is stepped by exactly one recording frame at a time, each step waits
+// for the medias and the screen to be rendered at that time, and for room in the queue, so no frame is ever dropped.
+// The render loops and the medias run without their fps limits meanwhile, as fast as the GPU and the encoder allow.
+class ScreenRecorder :
+	public ControllableContainer,
+	public StatsPublisher::Source,
+	public Timer,
+	public AsyncUpdater
+{
+public:
+	ScreenRecorder(Screen* screen);
+	~ScreenRecorder();
+
+	enum Mode { REALTIME, OFFLINE };
+
+	Screen* screen;
+
+	BoolParameter* record;
+	EnumParameter* mode;
+	FileParameter* outputFile;
+	IntParameter* fps;
+	FloatParameter* startTime;
+	FloatParameter* duration;
+	StringParameter* ffmpegPath;
+	StringParameter* encoderOptions;
+	IntParameter* maxQueuedFrames;
+	IntParameter* recordedFrames;
+	IntParameter* droppedFrames;
+
+	// One per recording, shared with the readback callbacks and the writer thread.
+	// Stopping only flags it, the writer drains the queue, closes the pipe and lets it go, even if the recorder is gone.
+	struct Session
+	{
+		String name;
+		Point<int> frameSize;
+		int fps = 30;
+		int queueLimit = 8;
+		bool isOffline = false;
+		FILE* pipe = nullptr;
+
+		// A frame of the video, queued in order when its slot comes. Captures are ready once read back,
+		// without data the writer repeats the previous frame
+		struct Frame
+		{
+			std::unique_ptr<MemoryBlock> data;
+			bool isReady = false;
+		};
+
+		CriticalSection queueLock;
+		OwnedArray<Frame> queue;
+		OwnedArray<MemoryBlock> freeBlocks;
+		WaitableEvent frameQueued;
+
+		//GL thread, realtime
+		double startTime = 0;
+		int64 numSlots = 0;
+
+		std::atomic<int> numRecorded { 0 };
+		std::atomic<int> numDropped { 0 };
+		std::atomic<bool> isStopping { false };
+
+		int getNumQueued(); //captures queued or being read back
+
+		//GL thread
+		Frame* addFrame(bool isCapture);
+		void removeFrame(Frame* f); //capture refused by the readback
+
+		//readback worker thread, data is null when the readback failed
+		void frameReadBack(Frame* f, const void* data, int lineStride);
+
+		//writer thread, until stopped and drained
+		void write();
+	};
+
+	// Thread writing a session to its encoder, it outlives the recorder until the session is drained.
+	// Kept in the writers list, so the app can join the ones still finishing when it quits
+	class Writer :
+		public Thread
+	{
+	public:
+		Writer(std::shared_ptr<Session> session);
+		std::shared_ptr<Session> session;
+		void run() override;
+	};
+
+	static OwnedArray<Writer> writers;
+	static CriticalSection writersLock;
+
+	//app shutdown, after the screens are deleted. Waits for the writers to drain, then stops them
+	static void joinWriters(int timeoutMs);
+
+	//null when not recording, read by the GL thread
+	std::shared_ptr<Session> session;
+	SpinLock sessionLock;
+	std::shared_ptr<Session> getSession();
+
+	//message thread, last recording, its counts keep being published while the writer finishes
+	std::shared_ptr<Session> statsSession;
+
+	//offline, step being rendered. Ticks of the render loops when its time was set, they have to move on before capturing
+	int offlineFrame;
+	int numOfflineFrames;
+	std::atomic<int> pendingFrame; //-1 when no step is waiting for its capture
+	std::atomic<int64> mainTickAtStep;
+	std::atomic<int64> productionTickAtStep;
+
+	void onContainerParameterChangedInternal(Parameter* p) override;
+
+	void startRecording();
+	void stopRecording();
+
+	//GL thread, after the screen was rendered. Ticks of the render loops when the screen started rendering, -1 without production thread
+	void frameRendered(PooledFrameBuffer& frameBuffer, int64 mainTick, int64 productionTick);
+
+	//message thread
+	void handleAsyncUpdate() override;
+	void timerCallback() override;
+	void publishStats() override;
+
+private:
+	bool captureFrame(std::shared_ptr<Session> s, GLuint texture); //queues the capture, false when the readback refused it
+	void setTime(double time);
+	void stepOffline();
+	String getCommand(const Session& s) const;
+};
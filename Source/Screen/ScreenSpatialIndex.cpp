@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+	ScreenSpatialIndex.cpp
+	Created: 18 Oct 2026 10:12:37am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Screen/ScreenIncludes.h"
+
+ScreenSpatialIndex::ScreenSpatialIndex(Screen* screen) :
+	screen(screen),
+	isDirty(true)
+{
+	handleCells.resize(gridSize * gridSize);
+	surfaceCells.resize(gridSize * gridSize);
+}
+
+ScreenSpatialIndex::~ScreenSpatialIndex()
+{
+}
+
+void ScreenSpatialIndex::setDirty()
+{
+	ScopedLock l(lock);
+	isDirty = true;
+}
+
+void ScreenSpatialIndex::handleMoved(Point2DParameter* handle)
+{
+	ScopedLock l(lock);
+	if (isDirty || !handleIndices.contains(handle)) return;
+
+	HandleEntry& e = handles.getReference(handleIndices[handle]);
+	Point<int> c = getCell(handle->getPoint());
+	const int cell = c.y * gridSize + c.x;
+	if (cell != e.cell)
+	{
+		handleCells.getReference(e.cell).removeFirstMatchingValue(handleIndices[handle]);
+		handleCells.getReference(cell).add(handleIndices[handle]);
+		e.cell = cell;
+	}
+
+	//corners move the bounds of their surface
+	if (e.isCorner) updateSurfaceCells(e.surfaceIndex);
+}
+
+Point2DParameter* ScreenSpatialIndex::getClosestHandle(Point<float> pos, float maxDistance, const Array<Point2DParameter*>& excludeHandles)
+{
+	ScopedLock l(lock);
+	rebuildIfDirty();
+
+	Point2DParameter* result = nullptr;
+	int resultOrder = INT32_MAX;
+	float closestDist = maxDistance;
+
+	//rings of cells around the position, until no unvisited cell can hold a closer handle
+	Point<int> center = getCell(pos);
+	for (int r = 0; r < gridSize; r++)
+	{
+		Rectangle<int> ring(center.x - r, center.y - r, r * 2 + 1, r * 2 + 1);
+		Rectangle<int> visited = ring.getIntersection(Rectangle<int>(0, 0, gridSize, gridSize));
+
+		for (int y = visited.getY(); y < visited.getBottom(); y++)
+		{
+			//only the border of the ring, inner cells were visited by the previous rings
+			const bool fullRow = y == ring.getY() || y == ring.getBottom() - 1;
+			const int step = fullRow ? 1 : jmax(ring.getWidth() - 1, 1);
+
+			for (int x = ring.getX(); x < ring.getRight(); x += step)
+			{
+				if (x < 0 || x >= gridSize) continue;
+
+				for (int index : handleCells.getReference(y * gridSize + x))
+				{
+					const HandleEntry& e = handles.getReference(index);
+					if (excludeHandles.contains(e.handle)) continue;
+
+					float dist = e.handle->getPoint().getDistanceFrom(pos);
+					if (maxDistance > 0 && dist > maxDistance) continue;
+					if (dist < closestDist || (dist == closestDist && result != nullptr && e.order < resultOrder))
+					{
+						result = e.handle;
+						resultOrder = e.order;
+						closestDist = dist;
+					}
+				}
+			}
+		}
+
+		if (visited == Rectangle<int>(0, 0, gridSize, gridSize)) break;
+
+		//distance from the position to the closest cell not visited yet, sides that reached the border of the grid have none left
+		Rectangle<float> bounds = getCellBounds(ring);
+		float reach = std::numeric_limits<float>::max();
+		if (ring.getX() > 0) reach = jmin(reach, pos.x - bounds.getX());
+		if (ring.getRight() < gridSize) reach = jmin(reach, bounds.getRight() - pos.x);
+		if (ring.getY() > 0) reach = jmin(reach, pos.y - bounds.getY());
+		if (ring.getBottom() < gridSize) reach = jmin(reach, bounds.getBottom() - pos.y);
+		if (reach > closestDist) break;
+	}
+
+	return result;
+}
+
+Array<Point2DParameter*> ScreenSpatialIndex::getOverlapHandles(Point2DParameter* handle)
+{
+	ScopedLock l(lock);
+	rebuildIfDirty();
+
+	Array<Point2DParameter*> result;
+	Point<float> p = handle->getPoint();
+	Point<int> c = getCell(p);
+
+	Array<int> indices = handleCells.getReference(c.y * gridSize + c.x);
+	indices.sort();
+	for (int index : indices)
+	{
+		const HandleEntry& e = handles.getReference(index);
+		if (!e.isCorner || e.handle == handle) continue;
+		if (e.handle->getPoint() == p) result.add(e.handle);
+	}
+
+	return result;
+}
+
+Surface* ScreenSpatialIndex::getSurfaceAt(Point<float> pos)
+{
+	ScopedLock l(lock);
+	rebuildIfDirty();
+
+	Point<int> c = getCell(pos);
+	Surface* result = nullptr;
+	int resultIndex = INT32_MAX;
+
+	//first surface in order, as the cells don't keep it
+	for (int index : surfaceCells.getReference(c.y * gridSize + c.x))
+	{
+		if (index > resultIndex) continue;
+		Surface* s = surfaceEntries[index].surface;
+		if (s->isPointInside(pos))
+		{
+			result = s;
+			resultIndex = index;
+		}
+	}
+
+	return result;
+}
+
+void ScreenSpatialIndex::rebuildIfDirty()
+{
+	if (!isDirty) return;
+	isDirty = false;
+
+	handles.clearQuick();
+	handleIndices.clear();
+	surfaceEntries.clearQuick();
+	for (auto& c : handleCells) c.clearQuick();
+	for (auto& c : surfaceCells) c.clearQuick();
+
+	//same selection as the editor always made : enabled surfaces, handles of the unlocked ones only
+	for (auto& s : screen->surfaces.items)
+	{
+		if (!s->enabled->boolValue()) continue;
+
+		const int surfaceIndex = surfaceEntries.size();
+		surfaceEntries.add({ s, Rectangle<int>() });
+		updateSurfaceCells(surfaceIndex);
+
+		if (s->isUILocked->boolValue()) continue;
+
+		for (auto& h : { s->topLeft, s->topRight, s->bottomLeft, s->bottomRight }) addHandle(h, surfaceIndex, true);
+		if (s->bezierCC.enabled->boolValue())
+		{
+			for (auto& h : s->getBezierHandles()) addHandle(h, surfaceIndex, false);
+		}
+		for (auto& p : s->pinsCC.items) addHandle(p->position, surfaceIndex, false);
+	}
+}
+
+void ScreenSpatialIndex::addHandle(Point2DParameter* handle, int surfaceIndex, bool isCorner)
+{
+	Point<int> c = getCell(handle->getPoint());
+	HandleEntry e = { handle, surfaceIndex, handles.size(), isCorner, c.y * gridSize + c.x };
+
+	handleIndices.set(handle, handles.size());
+	handleCells.getReference(e.cell).add(handles.size());
+	handles.add(e);
+}
+
+void ScreenSpatialIndex::updateSurfaceCells(int index)
+{
+	SurfaceEntry& e = surfaceEntries.getReference(index);
+
+	for (int y = e.cells.getY(); y < e.cells.getBottom(); y++)
+		for (int x = e.cells.getX(); x < e.cells.getRight(); x++)
+			surfaceCells.getReference(y * gridSize + x).removeFirstMatchingValue(index);
+
+	//from the corners, the path of the surface may not be updated yet
+	Surface* s = e.surface;
+	Point<float> corners[4] = { s->topLeft->getPoint(), s->topRight->getPoint(), s->bottomLeft->getPoint(), s->bottomRight->getPoint() };
+	Rectangle<float> bounds = Rectangle<float>::findAreaContainingPoints(corners, 4);
+	Point<int> from = getCell(bounds.getTopLeft());
+	Point<int> to = getCell(bounds.getBottomRight());
+	e.cells = Rectangle<int>(from.x, from.y, to.x - from.x + 1, to.y - from.y + 1);
+
+	for (int y = e.cells.getY(); y < e.cells.getBottom(); y++)
+		for (int x = e.cells.getX(); x < e.cells.getRight(); x++)
+			surfaceCells.getReference(y * gridSize + x).add(index);
+}
+
+Point<int> ScreenSpatialIndex::getCell(Point<float> pos) const
+{
+	//outside of the bounds goes in the border cells
+	const float cellSize = (gridMax - gridMin) / gridSize;
+	return Point<int>(jlimit(0, gridSize - 1, (int)std::floor((pos.x - gridMin) / cellSize)),
+		jlimit(0, gridSize - 1, (int)std::floor((pos.y - gridMin) / cellSize)));
+}
+
+Rectangle<float> ScreenSpatialIndex::getCellBounds(const Rectangle<int>& cells) const
+{
+	const float cellSize = (gridMax - gridMin) / gridSize;
+	return Rectangle<float>(gridMin + cells.getX() * cellSize, gridMin + cells.getY() * cellSize, cells.getWidth() * cellSize, cells.getHeight() * cellSize);
+}
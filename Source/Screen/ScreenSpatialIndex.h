@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+	ScreenSpatialIndex.h
+	Created: 18 Oct 2026 10:12:37am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class Screen;
+class Surface;
+
+// Uniform grid over the handles and surface bounds of a screen, for the editor picking and snapping.
+// A moved handle only changes cell, the grid is rebuilt when surfaces or pins are added, removed, enabled or locked.
+// Queries return the same results as scanning the surfaces in order.
+class ScreenSpatialIndex
+{
+public:
+	ScreenSpatialIndex(Screen* screen);
+	~ScreenSpatialIndex();
+
+	static const int gridSize = 96; //cells per side, handles are bounded from -1 to 2
+	static constexpr float gridMin = -1;
+	static constexpr float gridMax = 2;
+
+	struct HandleEntry
+	{
+		Point2DParameter* handle;
+		int surfaceIndex;
+		int order; //position in the scan order, breaks ties like the linear scan did
+		bool isCorner;
+		int cell;
+	};
+
+	struct SurfaceEntry
+	{
+		Surface* surface;
+		Rectangle<int> cells;
+	};
+
+	Screen* screen;
+	CriticalSection lock;
+	bool isDirty;
+
+	Array<HandleEntry> handles;
+	HashMap<Point2DParameter*, int> handleIndices;
+	Array<SurfaceEntry> surfaceEntries; //in surface order
+	Array<Array<int>> handleCells;
+	Array<Array<int>> surfaceCells;
+
+	void setDirty();
+	void handleMoved(Point2DParameter* handle);
+
+	Point2DParameter* getClosestHandle(Point<float> pos, float maxDistance, const Array<Point2DParameter*>& excludeHandles);
+	Array<Point2DParameter*> getOverlapHandles(Point2DParameter* handle);
+	Surface* getSurfaceAt(Point<float> pos);
+
+private:
+	void rebuildIfDirty();
+	void addHandle(Point2DParameter* handle, int surfaceIndex, bool isCorner);
+	void updateSurfaceCells(int index);
+
+	Point<int> getCell(Point<float> pos) const;
+	Rectangle<float> getCellBounds(const Rectangle<int>& cells) const;
+};
@@ -0,0 +1,391 @@
+/*
+  ==============================================================================
+
+	DelaunayTriangulation.cpp
+	Created: 17 Oct 2026 5:41:03pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Screen/ScreenIncludes.h"
+
+DelaunayTriangulation::DelaunayTriangulation() :
+	lastTriangle(-1),
+	cavityStamp(0)
+{
+}
+
+DelaunayTriangulation::~DelaunayTriangulation()
+{
+}
+
+bool DelaunayTriangulation::update(const Array<Point<float>>& newPoints)
+{
+	if (newPoints.size() != points.size() || triangles.isEmpty())
+	{
+		points = newPoints;
+		triangulate();
+		return true;
+	}
+
+	int changedIndex = -1;
+	int numChanged = 0;
+	for (int i = 0; i < newPoints.size(); i++)
+	{
+		if (newPoints.getUnchecked(i) == points.getUnchecked(i)) continue;
+		changedIndex = i;
+		numChanged++;
+	}
+
+	if (numChanged == 0) return false;
+
+	//dragging a pin only moves one point, its neighbourhood is enough
+	if (numChanged == 1 && movePoint(changedIndex, newPoints[changedIndex]))
+	{
+		buildIndices();
+		return true;
+	}
+
+	points = newPoints;
+	triangulate();
+	return true;
+}
+
+void DelaunayTriangulation::clear()
+{
+	points.clear();
+	triangles.clear();
+	freeTriangles.clear();
+	vertexTriangles.clear();
+	indices.clear();
+	cavityMarks.clear();
+	lastTriangle = -1;
+}
+
+void DelaunayTriangulation::triangulate()
+{
+	triangles.clearQuick();
+	freeTriangles.clearQuick();
+	vertexTriangles.clearQuick();
+	indices.clearQuick();
+	lastTriangle = -1;
+
+	const int numPoints = points.size();
+	if (numPoints < 3) return;
+
+	Rectangle<float> bounds = Rectangle<float>::findAreaFor(points.getRawDataPointer(), numPoints);
+	const float size = jmax(bounds.getWidth(), bounds.getHeight(), .001f);
+
+	//super triangle, its vertices come after the input points.
+	//Far enough that its circumcircles don't eat the hull triangles, doubles keep the tests exact enough at that scale
+	vertexTriangles.insertMultiple(0, -1, numPoints + 3);
+	superVertices[0] = Point<double>(bounds.getCentreX() - size * 2000.0, bounds.getCentreY() - size * 1000.0);
+	superVertices[1] = Point<double>(bounds.getCentreX() + size * 2000.0, bounds.getCentreY() - size * 1000.0);
+	superVertices[2] = Point<double>(bounds.getCentreX(), bounds.getCentreY() + size * 2000.0);
+	lastTriangle = createTriangle(numPoints, numPoints + 1, numPoints + 2);
+
+	//snake order over rows so each point is close to the previous one
+	const int numRows = jmax(1, (int)std::sqrt(numPoints / 2.0));
+	auto getRow = [&](int i) { return jlimit(0, numRows - 1, (int)((points[i].y - bounds.getY()) / size * numRows)); };
+
+	Array<int> order;
+	for (int i = 0; i < numPoints; i++) order.add(i);
+	std::sort(order.begin(), order.end(), [&](int a, int b)
+		{
+			int rowA = getRow(a);
+			int rowB = getRow(b);
+			if (rowA != rowB) return rowA < rowB;
+			return rowA % 2 == 0 ? points[a].x < points[b].x : points[a].x > points[b].x;
+		});
+
+	for (auto& i : order) insertPoint(i);
+
+	buildIndices();
+}
+
+void DelaunayTriangulation::insertPoint(int index)
+{
+	Point<double> p = getVertex(index);
+
+	int start = locate(p);
+	if (start < 0) return;
+
+	//two pins at the same place, the second one is left out of the mesh
+	for (int k = 0; k < 3; k++) if (getVertex(triangles[start].v[k]) == p) return;
+
+	if (cavityMarks.size() < triangles.size()) cavityMarks.insertMultiple(-1, 0, triangles.size() - cavityMarks.size());
+	cavityStamp++;
+
+	//all the triangles whose circumcircle contains the point, they form a star shaped hole around it
+	Array<int> cavity;
+	cavity.add(start);
+	cavityMarks.set(start, cavityStamp);
+
+	for (int c = 0; c < cavity.size(); c++)
+	{
+		const Triangle& t = triangles.getReference(cavity[c]);
+		for (int k = 0; k < 3; k++)
+		{
+			int nb = t.n[k];
+			if (nb < 0 || cavityMarks[nb] == cavityStamp) continue;
+			if (!isInCircumcircle(nb, p)) continue;
+
+			cavityMarks.set(nb, cavityStamp);
+			cavity.add(nb);
+		}
+	}
+
+	struct BoundaryEdge { int a; int b; int inside; int outside; };
+	Array<BoundaryEdge> boundary;
+	for (auto& c : cavity)
+	{
+		const Triangle& t = triangles.getReference(c);
+		for (int k = 0; k < 3; k++)
+		{
+			int nb = t.n[k];
+			if (nb >= 0 && cavityMarks[nb] == cavityStamp) continue;
+			boundary.add({ t.v[(k + 1) % 3], t.v[(k + 2) % 3], c, nb });
+		}
+	}
+
+	//fan the hole from the new point, the cavity slots are only freed after so the outside links stay unambiguous
+	Array<int> created;
+	for (auto& e : boundary)
+	{
+		int nt = createTriangle(e.a, e.b, index);
+		triangles.getReference(nt).n[2] = e.outside;
+		if (e.outside >= 0) replaceNeighbour(e.outside, e.inside, nt);
+		created.add(nt);
+	}
+
+	for (int i = 0; i < created.size(); i++)
+	{
+		Triangle& t = triangles.getReference(created[i]);
+		for (int j = 0; j < created.size(); j++)
+		{
+			const Triangle& o = triangles.getReference(created[j]);
+			if (o.v[0] == t.v[1]) t.n[0] = created[j]; //shares the edge going from b to the new point
+			if (o.v[1] == t.v[0]) t.n[1] = created[j]; //shares the edge coming from the new point to a
+		}
+
+		vertexTriangles.set(t.v[0], created[i]);
+		vertexTriangles.set(t.v[1], created[i]);
+	}
+
+	vertexTriangles.set(index, created.getLast());
+	lastTriangle = created.getLast();
+
+	for (auto& c : cavity)
+	{
+		triangles.getReference(c).v[0] = -1;
+		freeTriangles.add(c);
+	}
+}
+
+int DelaunayTriangulation::locate(Point<double> p) const
+{
+	//walk towards the point from the last insertion, crossing the edges it lies beyond
+	int t = lastTriangle;
+	for (int steps = 0; t >= 0 && steps < triangles.size(); steps++)
+	{
+		const Triangle& tri = triangles.getReference(t);
+		int next = -1;
+		for (int k = 0; k < 3 && next < 0; k++)
+		{
+			if (orient(tri.v[(k + 1) % 3], tri.v[(k + 2) % 3], p) < 0) next = tri.n[k];
+		}
+
+		if (next < 0) break;
+		t = next;
+	}
+
+	if (t >= 0 && triangles[t].v[0] >= 0)
+	{
+		const Triangle& tri = triangles.getReference(t);
+		if (orient(tri.v[1], tri.v[2], p) >= 0 && orient(tri.v[2], tri.v[0], p) >= 0 && orient(tri.v[0], tri.v[1], p) >= 0) return t;
+	}
+
+	//the walk left the mesh or went around in circles on degenerate input
+	for (int i = 0; i < triangles.size(); i++)
+	{
+		const Triangle& tri = triangles.getReference(i);
+		if (tri.v[0] < 0) continue;
+		if (orient(tri.v[1], tri.v[2], p) >= 0 && orient(tri.v[2], tri.v[0], p) >= 0 && orient(tri.v[0], tri.v[1], p) >= 0) return i;
+	}
+
+	return -1;
+}
+
+bool DelaunayTriangulation::movePoint(int index, Point<float> pos)
+{
+	const int t0 = vertexTriangles[index];
+	if (t0 < 0) return false;
+
+	//triangles around the vertex, turning from one to the next through the edges it shares with them
+	Array<int> star;
+	int t = t0;
+	do
+	{
+		const Triangle& tri = triangles.getReference(t);
+		int k = tri.v[0] == index ? 0 : tri.v[1] == index ? 1 : 2;
+		star.add(t);
+		t = tri.n[(k + 1) % 3];
+		if (t < 0 || star.size() > triangles.size()) return false;
+	} while (t != t0);
+
+	points.set(index, pos);
+
+	//the point left the polygon of its neighbours, the mesh would fold over
+	for (auto& s : star)
+	{
+		const Triangle& tri = triangles.getReference(s);
+		if (orient(tri.v[0], tri.v[1], getVertex(tri.v[2])) <= 0) return false;
+	}
+
+	Array<std::pair<int, int>> edges;
+	for (auto& s : star) for (int k = 0; k < 3; k++) edges.add({ s, k });
+
+	return legalize(edges);
+}
+
+bool DelaunayTriangulation::legalize(Array<std::pair<int, int>>& edges)
+{
+	//Lawson flips, any locally non Delaunay edge is flipped and the edges around it checked again
+	int numFlips = 0;
+	while (!edges.isEmpty())
+	{
+		std::pair<int, int> edge = edges.removeAndReturn(edges.size() - 1);
+		const int t = edge.first;
+		const int e = edge.second;
+
+		const Triangle& tri = triangles.getReference(t);
+		if (tri.v[0] < 0) continue;
+
+		const int u = tri.n[e];
+		if (u < 0) continue;
+
+		const Triangle& other = triangles.getReference(u);
+		int f = other.n[0] == t ? 0 : other.n[1] == t ? 1 : other.n[2] == t ? 2 : -1;
+		if (f < 0) continue;
+
+		const int d = other.v[f];
+		if (!isInCircumcircle(t, getVertex(d))) continue;
+
+		//only convex quads can be flipped
+		const int p = tri.v[e];
+		const int q1 = tri.v[(e + 1) % 3];
+		const int q2 = tri.v[(e + 2) % 3];
+		if (orient(p, q1, getVertex(d)) <= 0 || orient(d, q2, getVertex(p)) <= 0) continue;
+
+		flip(t, e);
+		if (++numFlips > triangles.size() * 4) return false;
+
+		edges.add({ t, 0 });
+		edges.add({ t, 2 });
+		edges.add({ u, 0 });
+		edges.add({ u, 2 });
+	}
+
+	return true;
+}
+
+void DelaunayTriangulation::flip(int t, int e)
+{
+	//t = (p, q1, q2) and u = (d, q2, q1) share q1-q2, they become (p, q1, d) and (d, q2, p)
+	Triangle& tri = triangles.getReference(t);
+	const int u = tri.n[e];
+	Triangle& other = triangles.getReference(u);
+	const int f = other.n[0] == t ? 0 : other.n[1] == t ? 1 : 2;
+
+	const int p = tri.v[e];
+	const int q1 = tri.v[(e + 1) % 3];
+	const int q2 = tri.v[(e + 2) % 3];
+	const int d = other.v[f];
+
+	const int nA = tri.n[(e + 2) % 3]; //across p-q1
+	const int nB = tri.n[(e + 1) % 3]; //across q2-p
+	const int nC = other.n[(f + 2) % 3]; //across d-q2
+	const int nD = other.n[(f + 1) % 3]; //across q1-d
+
+	tri = { { p, q1, d }, { nD, u, nA } };
+	other = { { d, q2, p }, { nB, t, nC } };
+
+	if (nD >= 0) replaceNeighbour(nD, u, t);
+	if (nB >= 0) replaceNeighbour(nB, t, u);
+
+	vertexTriangles.set(p, t);
+	vertexTriangles.set(q1, t);
+	vertexTriangles.set(d, u);
+	vertexTriangles.set(q2, u);
+}
+
+void DelaunayTriangulation::buildIndices()
+{
+	indices.clearQuick();
+
+	const int numPoints = points.size();
+	for (auto& t : triangles)
+	{
+		if (t.v[0] < 0) continue;
+		if (t.v[0] >= numPoints || t.v[1] >= numPoints || t.v[2] >= numPoints) continue;
+
+		indices.add(t.v[0]);
+		indices.add(t.v[1]);
+		indices.add(t.v[2]);
+	}
+}
+
+int DelaunayTriangulation::createTriangle(int a, int b, int c)
+{
+	Triangle t = { { a, b, c }, { -1, -1, -1 } };
+	if (freeTriangles.isEmpty())
+	{
+		triangles.add(t);
+		return triangles.size() - 1;
+	}
+
+	int index = freeTriangles.removeAndReturn(freeTriangles.size() - 1);
+	triangles.set(index, t);
+	return index;
+}
+
+void DelaunayTriangulation::replaceNeighbour(int t, int oldNeighbour, int newNeighbour)
+{
+	Triangle& tri = triangles.getReference(t);
+	for (int k = 0; k < 3; k++)
+	{
+		if (tri.n[k] != oldNeighbour) continue;
+		tri.n[k] = newNeighbour;
+		return;
+	}
+}
+
+Point<double> DelaunayTriangulation::getVertex(int v) const
+{
+	if (v >= points.size()) return superVertices[v - points.size()];
+	Point<float> p = points.getUnchecked(v);
+	return Point<double>(p.x, p.y);
+}
+
+double DelaunayTriangulation::orient(int a, int b, Point<double> p) const
+{
+	//> 0 when p is on the left of a -> b
+	Point<double> pa = getVertex(a);
+	Point<double> pb = getVertex(b);
+	return (pb.x - pa.x) * (p.y - pa.y) - (pb.y - pa.y) * (p.x - pa.x);
+}
+
+bool DelaunayTriangulation::isInCircumcircle(int t, Point<double> p) const
+{
+	const Triangle& tri = triangles.getReference(t);
+	Point<double> a = getVertex(tri.v[0]) - p;
+	Point<double> b = getVertex(tri.v[1]) - p;
+	Point<double> c = getVertex(tri.v[2]) - p;
+
+	const double det = (a.x * a.x + a.y * a.y) * (b.x * c.y - c.x * b.y)
+		- (b.x * b.x + b.y * b.y) * (a.x * c.y - c.x * a.y)
+		+ (c.x * c.x + c.y * c.y) * (a.x * b.y - b.x * a.y);
+
+	return det > 0;
+}
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+	DelaunayTriangulation.h
+	Created: 17 Oct 2026 5:41:03pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Incremental Bowyer-Watson triangulation of the pins of a surface.
+// Points are inserted along a snake curve so locating each one is a short walk from the previous insertion,
+// keeping the whole build around O(n log n). The triangulation and its index buffer are kept between updates:
+// when a single point moves inside the ring of its neighbours, Delaunay is restored locally with edge flips,
+// anything else triggers a rebuild.
+class DelaunayTriangulation
+{
+public:
+	DelaunayTriangulation();
+	~DelaunayTriangulation();
+
+	struct Triangle
+	{
+		int v[3]; //counter clockwise, v[0] == -1 for a free slot
+		int n[3]; //neighbour across the edge opposite to v[i], -1 on the outside
+	};
+
+	Array<Point<float>> points;
+	Array<Triangle> triangles;
+	Array<int> freeTriangles;
+	Array<int> vertexTriangles; //one triangle touching each vertex, -1 if the vertex was not inserted (duplicate)
+	Point<double> superVertices[3];
+	int lastTriangle;
+
+	Array<int> indices; //triangles of the input points, 3 per triangle, super triangle excluded
+
+	//returns true if the indices changed
+	bool update(const Array<Point<float>>& newPoints);
+	void clear();
+
+private:
+	Array<int> cavityMarks;
+	int cavityStamp;
+
+	void triangulate();
+	bool movePoint(int index, Point<float> pos);
+	void insertPoint(int index);
+	int locate(Point<double> p) const;
+	bool legalize(Array<std::pair<int, int>>& edges);
+	void flip(int t, int e);
+	void buildIndices();
+
+	int createTriangle(int a, int b, int c);
+	void replaceNeighbour(int t, int oldNeighbour, int newNeighbour);
+
+	Point<double> getVertex(int v) const;
+	double orient(int a, int b, Point<double> p) const;
+	bool isInCircumcircle(int t, Point<double> p) const;
+};
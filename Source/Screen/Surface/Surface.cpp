@@ -26,7 +26,23 @@ Surface::Surface(var params) :
 	objectType(params.getProperty("type", "Surface").toString()),
 	objectData(params),
 	previewMedia(nullptr),
-	shouldUpdateVertices(true)
+	vao(0),
+	vbo(0),
+	ebo(0),
+	ubo(0),
+	vboSize(0),
+	eboSize(0),
+	numElements(0),
+	geometryVersion(0),
+	paramsVersion(0),
+	uploadedParamsVersion(0),
+	alphaVersion(0),
+	alphaTexture(0),
+	bakedAlphaVersion(0),
+	bakedAlphaMask(0),
+	bakedAlphaMaskFrame(-1),
+	blendTexture(0),
+	bakedBlendVersion(0)
 
 {
 	saveAndLoadRecursiveData = true;
@@ -55,6 +71,7 @@ Surface::Surface(var params) :
 	handleBezierLeftBottom = bezierCC.addPoint2DParameter("Handle Left Bottom", "");
 	handleBezierRightTop = bezierCC.addPoint2DParameter("Handle Right Top", "");
 	handleBezierRightBottom = bezierCC.addPoint2DParameter("Handle Right Bottom", "");
+	gpuTessellation = bezierCC.addBoolParameter("GPU Tessellation", "Evaluate the bezier patch in the vertex shader. Moving the handles then only updates the control points instead of the whole mesh", false);
 
 	softEdgeTop = adjustmentsCC.addFloatParameter("Soft Edge Top", "", 0, 0, 1);
 	softEdgeRight = adjustmentsCC.addFloatParameter("Soft Edge Right", "", 0, 0, 1);
@@ -69,6 +86,7 @@ Surface::Surface(var params) :
 	showTestPattern = adjustmentsCC.addBoolParameter("Show Test Pattern", "If checked this will not use the media but generate a TestPatterns", false);
 	mask = adjustmentsCC.addTargetParameter("Mask", "Apply a mask to this surface", MediaManager::getInstance());
 	invertMask = adjustmentsCC.addBoolParameter("Invert mask", "Invert mask", false);
+	precomputeAlpha = adjustmentsCC.addBoolParameter("Precompute mask", "Combine the mask and soft edges in one texture, computed again only when they change. Saves work on each frame for still masks, the mask then follows the surface corners instead of the pins", false);
 
 	fillType = formatCC.addEnumParameter("Fill Type ", "");
 	fillType->addOption("Stretch", STRETCH)->addOption("Fit", FIT)->addOption("Fill", FILL);
@@ -123,6 +141,7 @@ Surface::Surface(var params) :
 	addChildControllableContainer(&adjustmentsCC);
 	addChildControllableContainer(&formatCC);
 	addChildControllableContainer(&pinsCC);
+	addChildControllableContainer(&renderTimer);
 
 	if (!Engine::mainEngine->isLoadingFile)
 	{
@@ -130,10 +149,35 @@ Surface::Surface(var params) :
 	}
 
 	updatePath();
+	requestMeshUpdate();
 }
 
 Surface::~Surface()
 {
+	if (SurfaceMeshBuilder::getInstanceWithoutCreating() != nullptr) SurfaceMeshBuilder::getInstance()->removeSurface(this);
+
+	//GL objects of a surface deleted while the context is still alive
+	Array<GLuint> queries;
+	if (renderTimer.queriesInitialized && renderTimer.gpuSupported)
+	{
+		queries.addArray(renderTimer.startQueries, RenderTimer::numQueries);
+		queries.addArray(renderTimer.endQueries, RenderTimer::numQueries);
+	}
+
+	if ((vao != 0 || alphaTexture != 0 || blendTexture != 0 || !queries.isEmpty()) && GlContextHolder::getInstanceWithoutCreating() != nullptr)
+	{
+		GLuint vaoToDelete = vao, vboToDelete = vbo, eboToDelete = ebo, uboToDelete = ubo, alphaToDelete = alphaTexture, blendToDelete = blendTexture;
+		GlContextHolder::getInstance()->executeOnGLThread([vaoToDelete, vboToDelete, eboToDelete, uboToDelete, alphaToDelete, blendToDelete, queries]()
+			{
+				if (vaoToDelete != 0) glDeleteVertexArrays(1, &vaoToDelete);
+				if (vboToDelete != 0) glDeleteBuffers(1, &vboToDelete);
+				if (eboToDelete != 0) glDeleteBuffers(1, &eboToDelete);
+				if (uboToDelete != 0) glDeleteBuffers(1, &uboToDelete);
+				if (alphaToDelete != 0) glDeleteTextures(1, &alphaToDelete);
+				if (blendToDelete != 0) glDeleteTextures(1, &blendToDelete);
+				if (!queries.isEmpty()) glDeleteQueries(queries.size(), queries.getRawDataPointer());
+			}, false);
+	}
 }
 
 void Surface::onContainerParameterChangedInternal(Parameter* p)
@@ -143,7 +187,11 @@ void Surface::onContainerParameterChangedInternal(Parameter* p)
 		if (Media* m = media->getTargetContainerAs<Media>()) registerUseMedia(SURFACE_TARGET_MEDIA_ID, m);
 		else unregisterUseMedia(SURFACE_TARGET_MEDIA_ID);
 
-		shouldUpdateVertices = true;
+		requestMeshUpdate();
+	}
+	else if (p == enabled)
+	{
+		notifyMediaUsageChanged();
 	}
 	if (p == isUILocked) {
 		bool e = !isUILocked->boolValue();
@@ -176,10 +224,19 @@ void Surface::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Co
 		resetBezierPoints();
 	}
 
+	if (c == softEdgeTop || c == softEdgeRight || c == softEdgeBottom || c == softEdgeLeft || c == invertMask || c == mask || c == precomputeAlpha)
+	{
+		alphaVersion++;
+	}
+
 	if (c == topLeft || c == topRight || c == bottomLeft || c == bottomRight)
 	{
 		updatePath();
 	}
+	else if (c == softEdgeTop || c == softEdgeRight || c == softEdgeBottom || c == softEdgeLeft || c == invertMask || c == ratio || c == bezierCC.enabled || c == gpuTessellation || c == precomputeAlpha)
+	{
+		paramsVersion++;
+	}
 	else if (c == mask)
 	{
 		if (Media* m = mask->getTargetContainerAs<Media>()) registerUseMedia(SURFACE_TARGET_MASK_ID, m);
@@ -208,6 +265,7 @@ void Surface::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Co
 		ShaderMedia* sm = nullptr;
 
 		unregisterUseMedia(SURFACE_PATTERN_ID);
+		paramsVersion++; //no precomputed alpha on the test pattern
 
 		if (showTestPattern->boolValue())
 		{
@@ -222,7 +280,18 @@ void Surface::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Co
 		patternMedia.reset(sm);
 	}
 
-	shouldUpdateVertices = true;
+	if (bezierCC.enabled->boolValue() && gpuTessellation->boolValue())
+	{
+		//the patch is evaluated in the vertex shader, control points only go to the uniform block
+		Point2DParameter* p = dynamic_cast<Point2DParameter*>(c);
+		if (p != nullptr && (getCornerHandles().contains(p) || getBezierHandles().contains(p)))
+		{
+			paramsVersion++;
+			return;
+		}
+	}
+
+	requestMeshUpdate();
 }
 
 void Surface::updatePath()
@@ -275,6 +344,18 @@ bool Surface::isUsingMedia(Media* m)
 	return MediaTarget::isUsingMedia(m);
 }
 
+OpenGLRenderer* Surface::getRenderConsumer()
+{
+	ControllableContainer* cc = parentContainer.get();
+	while (cc != nullptr)
+	{
+		if (Screen* s = dynamic_cast<Screen*>(cc)) return s->renderer.get();
+		cc = cc->parentContainer.get();
+	}
+
+	return nullptr;
+}
+
 Array<Point2DParameter*> Surface::getCornerHandles()
 {
 	return { topLeft, topRight, bottomLeft, bottomRight };
@@ -303,63 +384,118 @@ Array<Point2DParameter*> Surface::getBezierHandles(Point2DParameter* corner)
 	return { handleBezierTopLeft, handleBezierTopRight, handleBezierBottomLeft, handleBezierBottomRight, handleBezierLeftTop, handleBezierLeftBottom, handleBezierRightTop, handleBezierRightBottom };
 }
 
-int Surface::addToVertices(Point<float> posDisplay, Point<float> internalCoord, Vector3D<float> texCoord, Vector3D<float> maskCoord)
+int Surface::addToVertices(SurfaceGeometry& g, Point<float> posDisplay, Point<float> internalCoord, Vector3D<float> texCoord, Vector3D<float> maskCoord)
 {
-	vertices.add(posDisplay.x);
-	vertices.add(posDisplay.y);
-	vertices.add(internalCoord.x);
-	vertices.add(internalCoord.y);
-	vertices.add(texCoord.x);
-	vertices.add(texCoord.y);
-	vertices.add(texCoord.z);
-	vertices.add(maskCoord.x);
-	vertices.add(maskCoord.y);
-	vertices.add(maskCoord.z);
-	int nVertices = vertices.size() / 10;
+	g.vertices.add(posDisplay.x);
+	g.vertices.add(posDisplay.y);
+	g.vertices.add(internalCoord.x);
+	g.vertices.add(internalCoord.y);
+	g.vertices.add(texCoord.x);
+	g.vertices.add(texCoord.y);
+	g.vertices.add(texCoord.z);
+	g.vertices.add(maskCoord.x);
+	g.vertices.add(maskCoord.y);
+	g.vertices.add(maskCoord.z);
+	int nVertices = g.vertices.size() / 10;
 	return nVertices - 1;
 }
 
-void Surface::addLastFourAsQuad()
+void Surface::addLastFourAsQuad(SurfaceGeometry& g)
 {
-	int nVertices = vertices.size() / 10;
+	int nVertices = g.vertices.size() / 10;
 	if (nVertices >= 4) {
-		verticesElements.add(nVertices - 4);
-		verticesElements.add(nVertices - 3);
-		verticesElements.add(nVertices - 2);
-		verticesElements.add(nVertices - 3);
-		verticesElements.add(nVertices - 2);
-		verticesElements.add(nVertices - 1);
+		g.elements.add(nVertices - 4);
+		g.elements.add(nVertices - 3);
+		g.elements.add(nVertices - 2);
+		g.elements.add(nVertices - 3);
+		g.elements.add(nVertices - 2);
+		g.elements.add(nVertices - 1);
 	}
 }
 
-void Surface::updateVertices()
+void Surface::requestMeshUpdate()
 {
-	ScopedLock l(verticesLock);
+	if (Engine::mainEngine == nullptr || Engine::mainEngine->isClearing) return;
+	if (SurfaceMeshBuilder* builder = SurfaceMeshBuilder::getInstance()) builder->requestUpdate(this, getMeshInput());
+}
+
+Surface::MeshInput Surface::getMeshInput()
+{
+	MeshInput in;
+
+	in.topLeft = topLeft->getPoint();
+	in.topRight = topRight->getPoint();
+	in.bottomLeft = bottomLeft->getPoint();
+	in.bottomRight = bottomRight->getPoint();
+	in.handleTopLeft = handleBezierTopLeft->getPoint();
+	in.handleTopRight = handleBezierTopRight->getPoint();
+	in.handleBottomLeft = handleBezierBottomLeft->getPoint();
+	in.handleBottomRight = handleBezierBottomRight->getPoint();
+	in.handleLeftTop = handleBezierLeftTop->getPoint();
+	in.handleLeftBottom = handleBezierLeftBottom->getPoint();
+	in.handleRightTop = handleBezierRightTop->getPoint();
+	in.handleRightBottom = handleBezierRightBottom->getPoint();
+	in.bezier = bezierCC.enabled->boolValue();
+	in.gpuTessellation = gpuTessellation->boolValue();
+
+	in.cropTop = cropTop->floatValue();
+	in.cropRight = cropRight->floatValue();
+	in.cropBottom = cropBottom->floatValue();
+	in.cropLeft = cropLeft->floatValue();
+	in.fillType = fillType->getValueDataAsEnum<FillType>();
+	in.ratio = ratio->floatValue();
+
+	if (Media* med = media->getTargetContainerAs<Media>()) {
+		in.hasMedia = true;
+		in.mediaSize = med->getMediaSize();
+		in.mediaFlipY = med->flipY;
+	}
+	if (Media* msk = mask->getTargetContainerAs<Media>()) in.maskFlipY = msk->flipY;
+
+	for (int i = 0; i < pinsCC.items.size(); i++) {
+		Pin* p = pinsCC.items[i];
+		if (p->enabled->boolValue()) {
+			in.pins.add({ p->position->getPoint(), p->mediaPos->getPoint(), p->ponderation->floatValue() });
+		}
+	}
+
+	in.screenSize.setXY(1920, 1080);
+	if (Screen* s = getScreen()) in.screenSize.setXY(s->screenWidth->intValue(), s->screenHeight->intValue());
+
+	return in;
+}
 
-	vertices.clear();
-	verticesElements.clear();
+std::shared_ptr<const SurfaceGeometry> Surface::getGeometry()
+{
+	GenericScopedLock lock(geometryLock);
+	return geometry;
+}
 
-	Media* med = media->getTargetContainerAs<Media>();
+void Surface::updateVertices(const MeshInput& in)
+{
+	//built in a new snapshot, the renderers keep drawing the previous one until it is published
+	std::shared_ptr<SurfaceGeometry> g = std::make_shared<SurfaceGeometry>();
+	g->version = ++geometryVersion;
 
-	Point<float>tl = openGLPoint(topLeft);
-	Point<float>tr = openGLPoint(topRight);
-	Point<float>bl = openGLPoint(bottomLeft);
-	Point<float>br = openGLPoint(bottomRight);
+	Point<float>tl = openGLPoint(in.topLeft);
+	Point<float>tr = openGLPoint(in.topRight);
+	Point<float>bl = openGLPoint(in.bottomLeft);
+	Point<float>br = openGLPoint(in.bottomRight);
 
 	Point<float> center(0, 0);
 	intersection(tl, br, bl, tr, &center);
 
-	Vector3D<float> tlTex(cropLeft->floatValue(), 1 - cropTop->floatValue(), 1.0f);
-	Vector3D<float> trTex(1 - cropRight->floatValue(), 1 - cropTop->floatValue(), 1.0f);
-	Vector3D<float> blTex(cropLeft->floatValue(), cropBottom->floatValue(), 1.0f);
-	Vector3D<float> brTex(1 - cropRight->floatValue(), cropBottom->floatValue(), 1.0f);
+	Vector3D<float> tlTex(in.cropLeft, 1 - in.cropTop, 1.0f);
+	Vector3D<float> trTex(1 - in.cropRight, 1 - in.cropTop, 1.0f);
+	Vector3D<float> blTex(in.cropLeft, in.cropBottom, 1.0f);
+	Vector3D<float> brTex(1 - in.cropRight, in.cropBottom, 1.0f);
 
 	float hTex = tlTex.y - blTex.y;
 	float wTex = trTex.x - tlTex.x;
 	float texMidX = blTex.x + (wTex / 2.0f);
 	float texMidY = blTex.y + (hTex / 2.0f);
 
-	if (med != nullptr && med->flipY) {
+	if (in.mediaFlipY) {
 		tlTex.y = 1 - tlTex.y;
 		trTex.y = 1 - trTex.y;
 		blTex.y = 1 - blTex.y;
@@ -367,15 +503,15 @@ void Surface::updateVertices()
 		texMidY = 1 - texMidY;
 	}
 
-	FillType t = fillType->getValueDataAsEnum<FillType>();
+	FillType t = in.fillType;
 
 	if (t != STRETCH) {
-		float outputRatio = ratio->floatValue();
+		float outputRatio = in.ratio;
 
 		if (hTex == 0) hTex = 0.0000001;
 
-		if (med != nullptr) {
-			Point<int> mediaSize = med->getMediaSize();
+		if (in.hasMedia) {
+			Point<int> mediaSize = in.mediaSize;
 			float mediaRatio = abs((wTex * mediaSize.x) / (hTex * (float)mediaSize.y));
 			if (mediaRatio != outputRatio) {
 				if (t == FIT) {
@@ -440,8 +576,7 @@ void Surface::updateVertices()
 	Vector3D<float> blMask(0, 0, 1.0f);
 	Vector3D<float> brMask(1, 0, 1.0f);
 
-	Media* msk = mask->getTargetContainerAs<Media>();
-	if (msk != nullptr && msk->flipY) {
+	if (in.maskFlipY) {
 		tlMask.y = 1 - tlMask.y;
 		trMask.y = 1 - trMask.y;
 		blMask.y = 1 - blMask.y;
@@ -453,176 +588,130 @@ void Surface::updateVertices()
 	float dbr = center.getDistanceFrom(br);
 	float dbl = center.getDistanceFrom(bl);
 
-	if (bezierCC.enabled->boolValue()) {
-		const int gridSize = 40;
-		Point<float> grid[gridSize][gridSize];
-
-		for (int i = 0; i < gridSize; i++) {
-			for (int j = 0; j < gridSize; j++) {
-				grid[i][j] = Point<float>();
-			}
-		}
-
-		float distTop = 0;
-		float distBottom = 0;
-		for (int i = 0; i < gridSize; i++) {
-			float ratio = i / (float)(gridSize - 1);
-			grid[i][0] = getBeziers(openGLPoint(topLeft), openGLPoint(handleBezierTopLeft), openGLPoint(handleBezierTopRight), openGLPoint(topRight), ratio);
-			grid[i][gridSize - 1] = getBeziers(openGLPoint(bottomLeft), openGLPoint(handleBezierBottomLeft), openGLPoint(handleBezierBottomRight), openGLPoint(bottomRight), ratio);
-
-			if (i > 0) {
-				distTop += grid[i][0].getDistanceFrom(grid[i - 1][0]);
-				distBottom += grid[i][gridSize - 1].getDistanceFrom(grid[i - 1][gridSize - 1]);
+	if (in.bezier) {
+		const bool evaluateOnGPU = in.gpuTessellation;
+		Point<int> gridSize = evaluateOnGPU ? Point<int>(gpuTessellationSegments, gpuTessellationSegments) : getBezierGridSize(in);
+		const int numColumns = gridSize.x + 1;
+		const int numRows = gridSize.y + 1;
+
+		Array<Point<float>> grid;
+		grid.resize(numColumns * numRows);
+		auto cell = [&](int i, int j) -> Point<float>& { return grid.getReference(i * numRows + j); };
+
+		if (!evaluateOnGPU) {
+			float distTop = 0;
+			float distBottom = 0;
+			for (int i = 0; i < numColumns; i++) {
+				float ratio = i / (float)(numColumns - 1);
+				cell(i, 0) = getBeziers(tl, openGLPoint(in.handleTopLeft), openGLPoint(in.handleTopRight), tr, ratio);
+				cell(i, numRows - 1) = getBeziers(bl, openGLPoint(in.handleBottomLeft), openGLPoint(in.handleBottomRight), br, ratio);
+
+				if (i > 0) {
+					distTop += cell(i, 0).getDistanceFrom(cell(i - 1, 0));
+					distBottom += cell(i, numRows - 1).getDistanceFrom(cell(i - 1, numRows - 1));
+				}
 			}
-		}
 
-		Point<float>deltaHandleLT = openGLPoint(handleBezierLeftTop) - openGLPoint(topLeft);
-		Point<float>deltaHandleRT = openGLPoint(handleBezierRightTop) - openGLPoint(topRight);
-		Point<float>deltaHandleLB = openGLPoint(handleBezierLeftBottom) - openGLPoint(bottomLeft);
-		Point<float>deltaHandleRB = openGLPoint(handleBezierRightBottom) - openGLPoint(bottomRight);
+			Point<float>deltaHandleLT = openGLPoint(in.handleLeftTop) - tl;
+			Point<float>deltaHandleRT = openGLPoint(in.handleRightTop) - tr;
+			Point<float>deltaHandleLB = openGLPoint(in.handleLeftBottom) - bl;
+			Point<float>deltaHandleRB = openGLPoint(in.handleRightBottom) - br;
 
-		Point<float> deltaTop = deltaHandleRT - deltaHandleLT;
-		Point<float> deltaBottom = deltaHandleRB - deltaHandleLB;
+			Point<float> deltaTop = deltaHandleRT - deltaHandleLT;
+			Point<float> deltaBottom = deltaHandleRB - deltaHandleLB;
 
-		float currentDistTop = 0;
-		float currentDistBottom = 0;
-		for (int i = 0; i < gridSize; i++) {
-			if (i > 0) {
-				currentDistTop += grid[i][0].getDistanceFrom(grid[i - 1][0]);
-				currentDistBottom += grid[i][gridSize - 1].getDistanceFrom(grid[i - 1][gridSize - 1]);
-			}
+			float currentDistTop = 0;
+			float currentDistBottom = 0;
+			for (int i = 0; i < numColumns; i++) {
+				if (i > 0) {
+					currentDistTop += cell(i, 0).getDistanceFrom(cell(i - 1, 0));
+					currentDistBottom += cell(i, numRows - 1).getDistanceFrom(cell(i - 1, numRows - 1));
+				}
 
-			float ratioTop = currentDistTop / distTop;
-			float ratioBottom = currentDistBottom / distBottom;
+				float ratio = i / (float)(numColumns - 1);
+				float ratioTop = distTop > 0 ? currentDistTop / distTop : ratio;
+				float ratioBottom = distBottom > 0 ? currentDistBottom / distBottom : ratio;
 
-			Point<float> handleTop = deltaHandleLT + (deltaTop * ratioTop) + grid[i][0];
-			Point<float> handleBottom = deltaHandleLB + (deltaBottom * ratioBottom) + grid[i][gridSize - 1];
+				Point<float> handleTop = deltaHandleLT + (deltaTop * ratioTop) + cell(i, 0);
+				Point<float> handleBottom = deltaHandleLB + (deltaBottom * ratioBottom) + cell(i, numRows - 1);
 
-			for (int j = 1; j < gridSize - 1; j++) {
-				float ratio2 = j / (float)(gridSize - 1);
-				grid[i][j] = getBeziers(grid[i][0], handleTop, handleBottom, grid[i][gridSize - 1], ratio2);
+				for (int j = 1; j < numRows - 1; j++) {
+					float ratio2 = j / (float)(numRows - 1);
+					cell(i, j) = getBeziers(cell(i, 0), handleTop, handleBottom, cell(i, numRows - 1), ratio2);
+				}
 			}
-
 		}
 
-		float ratio = 1.0f / (float)(gridSize - 1);
-
-		float fromX = cropLeft->floatValue();
-		float toX = 1 - cropRight->floatValue();
-		float fromY = cropBottom->floatValue();
-		float toY = 1 - cropTop->floatValue();
-		if (med != nullptr && med->flipY) {
+		float fromX = in.cropLeft;
+		float toX = 1 - in.cropRight;
+		float fromY = in.cropBottom;
+		float toY = 1 - in.cropTop;
+		if (in.mediaFlipY) {
 			fromY = 1 - fromY;
 			toY = 1 - toY;
 		}
 
-		for (int i = 0; i < gridSize - 1; i++) {
-			for (int j = 0; j < gridSize - 1; j++) {
-				tlTex = Vector3D<float>(jmap(i * ratio, 0.0f, 1.0f, fromX, toX), jmap(1 - (j * ratio), 0.0f, 1.0f, fromY, toY), 1);
-				trTex = Vector3D<float>(jmap((i + 1) * ratio, 0.0f, 1.0f, fromX, toX), jmap(1 - (j * ratio), 0.0f, 1.0f, fromY, toY), 1);
-				blTex = Vector3D<float>(jmap(i * ratio, 0.0f, 1.0f, fromX, toX), jmap(1 - ((j + 1) * ratio), 0.0f, 1.0f, fromY, toY), 1);
-				brTex = Vector3D<float>(jmap((i + 1) * ratio, 0.0f, 1.0f, fromX, toX), jmap(1 - ((j + 1) * ratio), 0.0f, 1.0f, fromY, toY), 1);
-				tlMask = Vector3D<float>(i * ratio, 1 - (j * ratio), 1);
-				trMask = Vector3D<float>((i + 1) * ratio, 1 - (j * ratio), 1);
-				blMask = Vector3D<float>(i * ratio, 1 - ((j + 1) * ratio), 1);
-				brMask = Vector3D<float>((i + 1) * ratio, 1 - ((j + 1) * ratio), 1);
-				if (msk != nullptr && msk->flipY) {
-					tlMask.y = 1 - tlMask.y;
-					trMask.y = 1 - trMask.y;
-					blMask.y = 1 - blMask.y;
-					brMask.y = 1 - brMask.y;
-				}
-				addToVertices(grid[i][j], Point<float>(((i) * 2 * ratio) - 1, -(((j) * 2 * ratio) - 1)), tlTex, tlMask);
-				addToVertices(grid[i + 1][j], Point<float>(((i + 1) * 2 * ratio) - 1, -(((j) * 2 * ratio) - 1)), trTex, trMask);
-				addToVertices(grid[i][j + 1], Point<float>(((i) * 2 * ratio) - 1, -(((j + 1) * 2 * ratio) - 1)), blTex, blMask);
-				addToVertices(grid[i + 1][j + 1], Point<float>(((i + 1) * 2 * ratio) - 1, -(((j + 1) * 2 * ratio) - 1)), brTex, brMask);
-				addLastFourAsQuad();
+		//grid points are shared by the neighbouring cells
+		const int firstVertex = g->vertices.size() / 10;
+		for (int i = 0; i < numColumns; i++) {
+			for (int j = 0; j < numRows; j++) {
+				float u = i / (float)(numColumns - 1);
+				float v = j / (float)(numRows - 1);
+				Point<float> internalCoord(u * 2 - 1, -(v * 2 - 1));
+				Vector3D<float> tex(jmap(u, 0.0f, 1.0f, fromX, toX), jmap(1 - v, 0.0f, 1.0f, fromY, toY), 1);
+				Vector3D<float> maskCoord(u, 1 - v, 1);
+				if (in.maskFlipY) maskCoord.y = 1 - maskCoord.y;
+
+				//on the GPU the position comes from the control points, keep the vertices independent from them
+				addToVertices(*g, evaluateOnGPU ? internalCoord : cell(i, j), internalCoord, tex, maskCoord);
 			}
 		}
 
-
+		for (int i = 0; i < numColumns - 1; i++) {
+			for (int j = 0; j < numRows - 1; j++) {
+				GLuint vtl = firstVertex + i * numRows + j;
+				GLuint vtr = vtl + numRows;
+				GLuint vbl = vtl + 1;
+				GLuint vbr = vtr + 1;
+				g->elements.add(vtl);
+				g->elements.add(vtr);
+				g->elements.add(vbl);
+				g->elements.add(vtr);
+				g->elements.add(vbl);
+				g->elements.add(vbr);
+			}
+		}
 	}
 	else
 	{
-		Array<Pin*> pins;
-		if (pinsCC.items.size() > 0) {
-			for (int i = 0; i < pinsCC.items.size(); i++) {
-				if (pinsCC.items[i]->enabled->boolValue()) {
-					pins.add(pinsCC.items[i]);
-				}
-			}
-		}
+		//the corners are added as pins with the full ponderation
+		Array<MeshInput::PinData> pins = in.pins;
 
 		if (pins.size() > 0)
 		{
-			Pin ptl;
-			ptl.position->x = topLeft->x; ptl.position->y = topLeft->y;
-			ptl.mediaPos->x = tlTex.x; ptl.mediaPos->y = tlTex.y;
-			Pin ptr;
-			ptr.position->x = topRight->x; ptr.position->y = topRight->y;
-			ptr.mediaPos->x = trTex.x; ptr.mediaPos->y = trTex.y;
-			Pin pbl;
-			pbl.position->x = bottomLeft->x; pbl.position->y = bottomLeft->y;
-			pbl.mediaPos->x = blTex.x; pbl.mediaPos->y = blTex.y;
-			Pin pbr;
-			pbr.position->x = bottomRight->x; pbr.position->y = bottomRight->y;
-			pbr.mediaPos->x = brTex.x; pbr.mediaPos->y = brTex.y;
-
-			pins.add(&ptl);
-			pins.add(&ptr);
-			pins.add(&pbl);
-			pins.add(&pbr);
+			pins.add({ in.topLeft, Point<float>(tlTex.x, tlTex.y), 1 });
+			pins.add({ in.topRight, Point<float>(trTex.x, trTex.y), 1 });
+			pins.add({ in.bottomLeft, Point<float>(blTex.x, blTex.y), 1 });
+			pins.add({ in.bottomRight, Point<float>(brTex.x, brTex.y), 1 });
 
 			Array<int> verticeId;
 
-			for (int i = 0; i < pins.size(); i++)
+			for (auto& p : pins)
 			{
-				Point<float> pinPos = openGLPoint(pins[i]->position);
-				Point<float> pinMediaCoord = pins[i]->mediaPos->getPoint();
-				Vector3D<float> pinTex = Vector3D<float>(pinMediaCoord.x, pinMediaCoord.y, 1);
-				pinTex *= pins[i]->ponderation->floatValue();
-				Vector3D<float> pinMask = Vector3D<float>(pinMediaCoord.x, pinMediaCoord.y, 1);
-				pinMask *= pins[i]->ponderation->floatValue();
-				verticeId.add(addToVertices(pinPos, pinMediaCoord, pinTex, pinMask));
+				Point<float> pinPos = openGLPoint(p.position);
+				Vector3D<float> pinTex = Vector3D<float>(p.mediaPos.x, p.mediaPos.y, 1);
+				pinTex *= p.ponderation;
+				Vector3D<float> pinMask = Vector3D<float>(p.mediaPos.x, p.mediaPos.y, 1);
+				pinMask *= p.ponderation;
+				verticeId.add(addToVertices(*g, pinPos, p.mediaPos, pinTex, pinMask));
 			}
 
-			for (int iA = 0; iA < pins.size(); iA++)
-			{
-				Pin* pinA = pins[iA];
-				Point<float>a = pinA->position->getPoint();
-				for (int iB = iA + 1; iB < pins.size(); iB++)
-				{
-					Pin* pinB = pins[iB];
-					Point<float>b = pinB->position->getPoint();
-					for (int iC = iB + 1; iC < pins.size(); iC++)
-					{
-						Pin* pinC = pins[iC];
-						Point<float>c = pinC->position->getPoint();
-						if (pinA != pinB && pinB != pinC && pinA != pinC)
-						{
-							bool triangleIsValid = true;
-							for (int iD = 0; iD < pins.size() && triangleIsValid; iD++)
-							{
-								Pin* pinD = pins[iD];
-								Point<float>d = pinD->position->getPoint();
-								if (pinD != pinA && pinD != pinB && pinD != pinC)
-								{
-									if (isPointInsideCircumcircle(d, a, b, c))
-									{
-										triangleIsValid = false;
-									}
-								}
-							}
-							if (triangleIsValid) {
-								verticesElements.add(verticeId[iA]);
-								verticesElements.add(verticeId[iB]);
-								verticesElements.add(verticeId[iC]);
-							}
-						}
-					}
-				}
-			}
+			//only the pin positions matter, the mesh is kept and updated locally when a single pin moves
+			Array<Point<float>> pinPositions;
+			for (auto& p : pins) pinPositions.add(p.position);
+			pinsTriangulation.update(pinPositions);
 
+			for (auto& i : pinsTriangulation.indices) g->elements.add(verticeId[i]);
 		}
 		else
 		{
@@ -641,151 +730,241 @@ void Surface::updateVertices()
 			blMask *= zbl;
 			brMask *= zbr;
 
-			addToVertices(tl, Point<float>(-1, 1), tlTex, tlMask);
-			addToVertices(tr, Point<float>(1, 1), trTex, trMask);
-			addToVertices(bl, Point<float>(-1, -1), blTex, blMask);
-			addToVertices(br, Point<float>(1, -1), brTex, brMask);
-			addLastFourAsQuad();
+			addToVertices(*g, tl, Point<float>(-1, 1), tlTex, tlMask);
+			addToVertices(*g, tr, Point<float>(1, 1), trTex, trMask);
+			addToVertices(*g, bl, Point<float>(-1, -1), blTex, blMask);
+			addToVertices(*g, br, Point<float>(1, -1), brTex, brMask);
+			addLastFourAsQuad(*g);
 		}
 	}
+
+	GenericScopedLock lock(geometryLock);
+	geometry = g;
 }
 
-void Surface::draw(GLuint shaderID)
+Media* Surface::getDrawMedia()
 {
-	if (!enabled->boolValue()) return;
-
+	if (!enabled->boolValue()) return nullptr;
 
 	Media* media = getMedia();
 
+	GenericScopedLock lock(patternMediaLock);
+	if (patternMedia != nullptr)
 	{
-		GenericScopedLock lock(patternMediaLock);
-		if (patternMedia != nullptr)
-		{
-			Point<int> ms = media != nullptr ? media->getMediaSize() : Point<int>(512, 512);
-			patternMedia->width->setValue(ms.x);
-			patternMedia->height->setValue(ms.y);
-			media = patternMedia.get();
-		}
+		Point<int> ms = media != nullptr ? media->getMediaSize() : Point<int>(512, 512);
+		patternMedia->width->setValue(ms.x);
+		patternMedia->height->setValue(ms.y);
+		media = patternMedia.get();
 	}
 
-	if (media == nullptr) return;
-
-	Point<float> tl, tr, bl, br;
+	return media;
+}
 
-	Media* maskMedia = mask->getTargetContainerAs<Media>();// dynamic_cast<Media*>(mask->targetContainer.get());
-	std::shared_ptr<OpenGLTexture> texMask = nullptr;
+GLuint Surface::getMaskTextureID()
+{
+	if (showTestPattern->boolValue()) return 0;
+	if (alphaTexture != 0 && isAlphaPrecomputed()) return alphaTexture;
 
-	GLuint maskLocation = glGetUniformLocation(shaderID, "mask");
-	glUniform1i(maskLocation, 0);
-	glActiveTexture(GL_TEXTURE0);
+	Media* maskMedia = mask->getTargetContainerAs<Media>();
+	return maskMedia != nullptr ? maskMedia->getTextureID() : 0;
+}
 
-	if (maskMedia != nullptr && !showTestPattern->boolValue())
-	{
-		glBindTexture(GL_TEXTURE_2D, maskMedia->getTextureID());
-	}
-	else
+void Surface::fillParams(SurfaceParams& params)
+{
+	params = {};
+	params.borderSoft[0] = softEdgeTop->floatValue();
+	params.borderSoft[1] = softEdgeRight->floatValue();
+	params.borderSoft[2] = softEdgeBottom->floatValue();
+	params.borderSoft[3] = softEdgeLeft->floatValue();
+	params.invertMask = invertMask->boolValue() ? 1 : 0;
+	params.alphaMode = isAlphaPrecomputed() ? 1 : 0;
+	params.ratio = ratio->floatValue();
+	params.bezierMode = bezierCC.enabled->boolValue() && gpuTessellation->boolValue() ? 1 : 0;
+
+	Point2DParameter* controlPoints[12] = { topLeft, handleBezierTopLeft, handleBezierTopRight, topRight,
+		bottomLeft, handleBezierBottomLeft, handleBezierBottomRight, bottomRight,
+		handleBezierLeftTop, handleBezierLeftBottom, handleBezierRightTop, handleBezierRightBottom };
+
+	for (int i = 0; i < 12; i++)
 	{
-		juce::Image whiteImage(juce::Image::PixelFormat::ARGB, 1, 1, true);
-		whiteImage.setPixelAt(0, 0, Colours::white);
-		texMask = std::make_shared<OpenGLTexture>();
-		texMask->loadImage(whiteImage);
-		texMask->bind();
+		Point<float> p = openGLPoint(controlPoints[i]);
+		params.bezierPoints[i * 2] = p.x;
+		params.bezierPoints[i * 2 + 1] = p.y;
 	}
+}
+
+void Surface::draw(const SurfaceShaderLocations& locations)
+{
+	Media* media = getDrawMedia();
+	if (media == nullptr) return;
+
+	GLuint maskTexture = getMaskTextureID();
+	if (maskTexture == 0) maskTexture = GlContextHolder::getInstance()->getWhiteTextureID();
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, maskTexture);
 	glGetError();
 
 
 
-	GLuint textureLocation = glGetUniformLocation(shaderID, "tex");
-	glUniform1i(textureLocation, 1);
 	glActiveTexture(GL_TEXTURE1);
 	glGetError();
 
-	if (media == nullptr) return;
-
 	glBindTexture(GL_TEXTURE_2D, media->getTextureID());
 
+	drawGeometry(locations);
 
-	// vertices start
-	if (shouldUpdateVertices) {
-		shouldUpdateVertices = false;
-		updateVertices();
+	glActiveTexture(GL_TEXTURE1);
+	glDisable(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, 0);
 
-		glGenBuffers(1, &vbo);
-		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glActiveTexture(GL_TEXTURE0);
+	glDisable(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, 0);
 
-		posAttrib = glGetAttribLocation(shaderID, "position");
-		glVertexAttribPointer(posAttrib, 2, GL_FLOAT, GL_FALSE, 10 * sizeof(GLfloat), 0);
+	glGetError();
+}
 
-		surfacePosAttrib = glGetAttribLocation(shaderID, "surfacePosition");
-		glVertexAttribPointer(surfacePosAttrib, 2, GL_FLOAT, GL_FALSE, 10 * sizeof(GLfloat), (void*)(2 * sizeof(float)));
+void Surface::drawGeometry(const SurfaceShaderLocations& locations)
+{
+	if (vao == 0) initGL(locations);
 
-		texAttrib = glGetAttribLocation(shaderID, "texcoord");
-		glVertexAttribPointer(texAttrib, 3, GL_FLOAT, GL_FALSE, 10 * sizeof(float), (void*)(4 * sizeof(float)));
+	glBindVertexArray(vao);
+	uploadVertices();
+	uploadParams();
+	glBindBufferBase(GL_UNIFORM_BUFFER, paramsBindingPoint, ubo);
 
-		maskAttrib = glGetAttribLocation(shaderID, "maskcoord");
-		glVertexAttribPointer(maskAttrib, 3, GL_FLOAT, GL_FALSE, 10 * sizeof(float), (void*)(7 * sizeof(float)));
+	//glDrawElements(GL_LINES, numElements, GL_UNSIGNED_INT, 0);
+	glDrawElements(GL_TRIANGLES, numElements, GL_UNSIGNED_INT, 0);
+	glGetError();
 
-		borderSoftLocation = glGetUniformLocation(shaderID, "borderSoft");
-		glUniform4f(borderSoftLocation, softEdgeTop->floatValue(), softEdgeRight->floatValue(), softEdgeBottom->floatValue(), softEdgeLeft->floatValue());
+	glBindVertexArray(0);
+}
 
-		invertMaskLocation = glGetUniformLocation(shaderID, "invertMask");
-		glUniform1i(invertMaskLocation, invertMask->boolValue() ? 1 : 0);
+void Surface::initGL(const SurfaceShaderLocations& locations)
+{
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
 
-		ratioLocation = glGetUniformLocation(shaderID, "ratio");
-		glUniform1f(ratioLocation, ratio->floatValue());
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
 
-		glGenBuffers(1, &ebo);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+	glGenBuffers(1, &ebo);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
 
-	}
+	//layout is recorded in the VAO, only the buffer contents change afterwards
+	glVertexAttribPointer(locations.position, 2, GL_FLOAT, GL_FALSE, 10 * sizeof(GLfloat), 0);
+	glVertexAttribPointer(locations.surfacePosition, 2, GL_FLOAT, GL_FALSE, 10 * sizeof(GLfloat), (void*)(2 * sizeof(float)));
+	glVertexAttribPointer(locations.texcoord, 3, GL_FLOAT, GL_FALSE, 10 * sizeof(float), (void*)(4 * sizeof(float)));
+	glVertexAttribPointer(locations.maskcoord, 3, GL_FLOAT, GL_FALSE, 10 * sizeof(float), (void*)(7 * sizeof(float)));
 
-	glBindBuffer(GL_ARRAY_BUFFER, vbo);
-	glVertexAttribPointer(posAttrib, 2, GL_FLOAT, GL_FALSE, 10 * sizeof(GLfloat), 0);
-	glVertexAttribPointer(surfacePosAttrib, 2, GL_FLOAT, GL_FALSE, 10 * sizeof(GLfloat), (void*)(2 * sizeof(float)));
-	glVertexAttribPointer(texAttrib, 3, GL_FLOAT, GL_FALSE, 10 * sizeof(float), (void*)(4 * sizeof(float)));
-	glVertexAttribPointer(maskAttrib, 3, GL_FLOAT, GL_FALSE, 10 * sizeof(float), (void*)(7 * sizeof(float)));
-	glUniform4f(borderSoftLocation, softEdgeTop->floatValue(), softEdgeRight->floatValue(), softEdgeBottom->floatValue(), softEdgeLeft->floatValue());
-	glUniform1i(invertMaskLocation, invertMask->boolValue() ? 1 : 0);
-	glUniform1i(ratioLocation, ratio->floatValue());
-
-	glEnableVertexAttribArray(posAttrib);
+	glEnableVertexAttribArray(locations.position);
+	glEnableVertexAttribArray(locations.surfacePosition);
+	glEnableVertexAttribArray(locations.texcoord);
+	glEnableVertexAttribArray(locations.maskcoord);
 	glGetError();
 
-	glEnableVertexAttribArray(surfacePosAttrib);
-	glGetError();
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-	glEnableVertexAttribArray(texAttrib);
-	glGetError();
+	glGenBuffers(1, &ubo);
+	glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(SurfaceParams), nullptr, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	//make sure the first draw uploads
+	vboSize = 0;
+	eboSize = 0;
+	numElements = 0;
+	uploadedGeometry = nullptr;
+	uploadedParamsVersion = paramsVersion - 1;
+}
 
-	glEnableVertexAttribArray(maskAttrib);
-	glGetError();
+void Surface::uploadVertices()
+{
+	//the VAO is bound, so is its element buffer
+	std::shared_ptr<const SurfaceGeometry> g = getGeometry();
+	if (g == nullptr || g == uploadedGeometry) return;
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-	glGetError();
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
 
-	verticesLock.enter();
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vertices.size(), vertices.getRawDataPointer(), GL_STATIC_DRAW);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, verticesElements.size() * sizeof(GLuint), verticesElements.getRawDataPointer(), GL_STATIC_DRAW);
-	verticesLock.exit();
+	const Array<GLfloat>& vertices = g->vertices;
+	const int numFloats = vertices.size();
+	if (numFloats * (int)sizeof(GLfloat) > vboSize || uploadedGeometry == nullptr || numFloats != uploadedGeometry->vertices.size())
+	{
+		//storage only grows, a smaller mesh is written at the start of it
+		if (numFloats * (int)sizeof(GLfloat) > vboSize)
+		{
+			vboSize = numFloats * sizeof(GLfloat);
+			glBufferData(GL_ARRAY_BUFFER, vboSize, vertices.getRawDataPointer(), GL_DYNAMIC_DRAW);
+		}
+		else glBufferSubData(GL_ARRAY_BUFFER, 0, numFloats * sizeof(GLfloat), vertices.getRawDataPointer());
+	}
+	else
+	{
+		//same layout, only send the range that moved (usually the vertices around a dragged handle)
+		const Array<GLfloat>& uploadedVertices = uploadedGeometry->vertices;
+		int first = 0;
+		while (first < numFloats && vertices.getUnchecked(first) == uploadedVertices.getUnchecked(first)) first++;
 
-	//glDrawElements(GL_LINES, verticesElements.size(), GL_UNSIGNED_INT, 0);
-	glDrawElements(GL_TRIANGLES, verticesElements.size(), GL_UNSIGNED_INT, 0);
-	glGetError();
+		if (first < numFloats)
+		{
+			int last = numFloats - 1;
+			while (last > first && vertices.getUnchecked(last) == uploadedVertices.getUnchecked(last)) last--;
+			glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(GLfloat), (last - first + 1) * sizeof(GLfloat), vertices.getRawDataPointer() + first);
+		}
+	}
+
+	if (uploadedGeometry == nullptr || g->elements != uploadedGeometry->elements)
+	{
+		const int elementsSize = g->elements.size() * sizeof(GLuint);
+		if (elementsSize > eboSize)
+		{
+			eboSize = elementsSize;
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, eboSize, g->elements.getRawDataPointer(), GL_DYNAMIC_DRAW);
+		}
+		else glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, elementsSize, g->elements.getRawDataPointer());
+	}
+
+	numElements = g->elements.size();
+	uploadedGeometry = g;
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-	//glDeleteBuffers(1, &ebo);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	//glDeleteBuffers(1, &vbo);
+}
 
-	glActiveTexture(GL_TEXTURE1);
-	glDisable(GL_TEXTURE_2D);
-	glBindTexture(GL_TEXTURE_2D, 0);
+void Surface::uploadParams()
+{
+	if (uploadedParamsVersion == paramsVersion) return;
+	uploadedParamsVersion = paramsVersion;
 
-	glActiveTexture(GL_TEXTURE0);
-	glDisable(GL_TEXTURE_2D);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	SurfaceParams params;
+	fillParams(params);
 
-	glGetError();
+	glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(SurfaceParams), &params);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void Surface::releaseGL()
+{
+	if (vao != 0) glDeleteVertexArrays(1, &vao);
+	if (vbo != 0) glDeleteBuffers(1, &vbo);
+	if (ebo != 0) glDeleteBuffers(1, &ebo);
+	if (ubo != 0) glDeleteBuffers(1, &ubo);
+	if (alphaTexture != 0) glDeleteTextures(1, &alphaTexture);
+	if (blendTexture != 0) glDeleteTextures(1, &blendTexture);
+
+	vao = 0;
+	vbo = 0;
+	ebo = 0;
+	ubo = 0;
+	vboSize = 0;
+	eboSize = 0;
+	numElements = 0;
+	uploadedGeometry = nullptr;
+	alphaTexture = 0;
+	alphaTextureSize = Point<int>();
+	blendTexture = 0;
 }
 
 Media* Surface::getMedia()
@@ -794,11 +973,63 @@ Media* Surface::getMedia()
 }
 
 
+Screen* Surface::getScreen()
+{
+	for (ControllableContainer* cc = parentContainer.get(); cc != nullptr; cc = cc->parentContainer.get())
+	{
+		if (Screen* s = dynamic_cast<Screen*>(cc)) return s;
+	}
+
+	return nullptr;
+}
+
+bool Surface::isAlphaPrecomputed()
+{
+	if (showTestPattern->boolValue()) return false;
+	if (precomputeAlpha->boolValue()) return true;
+
+	//the blend maps of the screen are part of the precomputed alpha
+	Screen* s = getScreen();
+	return s != nullptr && s->autoBlend->boolValue();
+}
+
+Point<int> Surface::getBezierGridSize(const MeshInput& in)
+{
+	const float tolerance = .5f; //max distance in pixels between the curve and its segments
+	const float maxSegmentLength = 24; //texture coordinates are interpolated linearly along each segment
+	const int maxSegments = 64;
+
+	//openGL coordinates go from -1 to 1 over the screen
+	Point<float> pixelScale(in.screenSize.x / 2.0f, in.screenSize.y / 2.0f);
+
+	auto getNumSegments = [&](Point<float> a, Point<float> b, Point<float> c, Point<float> d)
+		{
+			Point<float> p0 = openGLPoint(a) * pixelScale;
+			Point<float> p1 = openGLPoint(b) * pixelScale;
+			Point<float> p2 = openGLPoint(c) * pixelScale;
+			Point<float> p3 = openGLPoint(d) * pixelScale;
+
+			//Wang's formula, bound of the cubic's second derivative
+			float m = jmax((p0 - p1 * 2 + p2).getDistanceFromOrigin(), (p1 - p2 * 2 + p3).getDistanceFromOrigin());
+			float curvatureSegments = std::sqrt(.75f * m / tolerance);
+			float lengthSegments = (p1.getDistanceFrom(p0) + p2.getDistanceFrom(p1) + p3.getDistanceFrom(p2)) / maxSegmentLength;
+
+			return jlimit(1, maxSegments, (int)std::ceil(jmax(curvatureSegments, lengthSegments)));
+		};
+
+	int numColumns = jmax(getNumSegments(in.topLeft, in.handleTopLeft, in.handleTopRight, in.topRight), getNumSegments(in.bottomLeft, in.handleBottomLeft, in.handleBottomRight, in.bottomRight));
+	int numRows = jmax(getNumSegments(in.topLeft, in.handleLeftTop, in.handleLeftBottom, in.bottomLeft), getNumSegments(in.topRight, in.handleRightTop, in.handleRightBottom, in.bottomRight));
+	return Point<int>(numColumns, numRows);
+}
+
 Point<float> Surface::getBeziers(Point<float>a, Point<float>b, Point<float>c, Point<float>d, float r) {
 
-	float x = (pow(1 - r, 3) * a.x) + (3 * (pow(1 - r, 2)) * r * b.x) + (3 * (pow(1 - r, 1)) * r * r * c.x) + (r * r * r * d.x);
-	float y = (pow(1 - r, 3) * a.y) + (3 * (pow(1 - r, 2)) * r * b.y) + (3 * (pow(1 - r, 1)) * r * r * c.y) + (r * r * r * d.y);
-	return Point<float>(x, y);
+	float mr = 1 - r;
+	float wa = mr * mr * mr;
+	float wb = 3 * mr * mr * r;
+	float wc = 3 * mr * r * r;
+	float wd = r * r * r;
+	return Point<float>(wa * a.x + wb * b.x + wc * c.x + wd * d.x, wa * a.y + wb * b.y + wc * c.y + wd * d.y);
 }
 
 bool Surface::intersection(Point<float> p1, Point<float> p2, Point<float> p3, Point<float> p4, Point<float>* intersect)
@@ -830,10 +1061,14 @@ bool Surface::intersection(Point<float> p1, Point<float> p2, Point<float> p3, Po
 
 Point<float> Surface::openGLPoint(Point2DParameter* p)
 {
-	Point<float> r = p->getPoint();
-	r.x = (r.x * 2) - 1;
-	r.y = (r.y * 2) - 1;
-	return r;
+	return openGLPoint(p->getPoint());
+}
+
+Point<float> Surface::openGLPoint(Point<float> p)
+{
+	p.x = (p.x * 2) - 1;
+	p.y = (p.y * 2) - 1;
+	return p;
 }
 
 
@@ -12,6 +12,37 @@
 
 
 class Media;
+class Screen;
+
+// Locations in the main surface shader, looked up once per program by the screen renderer
+struct SurfaceShaderLocations
+{
+	GLint position = -1;
+	GLint surfacePosition = -1;
+	GLint texcoord = -1;
+	GLint maskcoord = -1;
+	GLint surfaceIndex = -1; //batched shader only
+};
+
+// Per-surface parameters as laid out in the std140 SurfaceParams block of the surface shader
+struct SurfaceParams
+{
+	GLfloat borderSoft[4];
+	GLint invertMask;
+	GLfloat ratio;
+	GLint bezierMode; //1 when the vertex shader evaluates the patch
+	GLint alphaMode; //1 when the mask texture is the precomputed alpha of the surface
+	GLfloat bezierPoints[24]; //corners, top and bottom handles, left and right handles, in openGL coordinates
+};
+
+// Mesh of a surface, built by the SurfaceMeshBuilder and never modified once published.
+// Renderers keep a reference to the snapshot they uploaded, a newer one simply replaces it.
+struct SurfaceGeometry
+{
+	unsigned int version = 0;
+	Array<GLfloat> vertices; //10 floats per vertex : position, surface position, texture and mask coordinates
+	Array<GLuint> elements;
+};
 
 class Surface :
 	public BaseItem,
@@ -24,8 +55,6 @@ public:
 	String objectType;
 	var objectData;
 
-	bool shouldUpdateVertices;
-
 	TargetParameter* media;
 
 	std::unique_ptr<Media> patternMedia;
@@ -46,6 +75,9 @@ public:
 	Point2DParameter* handleBezierLeftBottom;
 	Point2DParameter* handleBezierRightTop;
 	Point2DParameter* handleBezierRightBottom;
+	BoolParameter* gpuTessellation;
+
+	static const int gpuTessellationSegments = 32;
 
 	BaseManager<Pin> pinsCC;
 
@@ -53,6 +85,7 @@ public:
 	BoolParameter* showTestPattern;
 	TargetParameter* mask;
 	BoolParameter* invertMask;
+	BoolParameter* precomputeAlpha;
 
 	ControllableContainer formatCC;
 	enum FillType { STRETCH, FIT, FILL };
@@ -72,19 +105,30 @@ public:
 	FloatParameter* cropBottom;
 	FloatParameter* cropLeft;
 
+	RenderTimer renderTimer;
+
 	Media* previewMedia;
 	Path quadPath;
 
-	// openGL variables
+	// openGL variables, persistent until the context closes
+	GLuint vao;
 	GLuint vbo;
-	GLint posAttrib;
-	GLint surfacePosAttrib;
-	GLint texAttrib;
-	GLint maskAttrib;
-	GLuint borderSoftLocation;
-	GLuint invertMaskLocation;
-	GLuint ratioLocation;
 	GLuint ebo;
+	GLuint ubo;
+	int vboSize;
+	int eboSize;
+	int numElements;
+	std::shared_ptr<const SurfaceGeometry> uploadedGeometry;
+	unsigned int uploadedParamsVersion;
+	GLuint alphaTexture; //mask x soft edges in surface coordinates, see SurfaceAlphaBaker
+	Point<int> alphaTextureSize;
+	unsigned int bakedAlphaVersion;
+	GLuint bakedAlphaMask;
+	int64 bakedAlphaMaskFrame; //renderedFrames of the mask media when baked
+	GLuint blendTexture; //overlap blend with the other surfaces of the screen, 0 when not overlapping
+	unsigned int bakedBlendVersion;
+
+	static const GLuint paramsBindingPoint = 0;
 
 
 	void onContainerParameterChangedInternal(Parameter* p);
@@ -97,20 +141,68 @@ public:
 	void resetBezierPoints();
 	Trigger* resetBezierBtn;
 
-	unsigned int verticesVersion;
-	Array<GLfloat> vertices;
-	Array<GLuint> verticesElements;
-	CriticalSection verticesLock;
-
-	int addToVertices(Point<float> posDisplay, Point<float>itnernalCoord, Vector3D<float> texCoord, Vector3D<float> maskCoord);
-	void addLastFourAsQuad();
-	void updateVertices();
-	void draw(GLuint shaderID);
+	// Copy of everything a mesh is built from, taken on the message thread when the update is requested
+	// so the builder never reads the parameters, the pins or the medias while they are being edited
+	struct MeshInput
+	{
+		struct PinData
+		{
+			Point<float> position;
+			Point<float> mediaPos;
+			float ponderation;
+		};
+
+		Point<float> topLeft, topRight, bottomLeft, bottomRight; //surface coordinates, as the parameters
+		Point<float> handleTopLeft, handleTopRight, handleBottomLeft, handleBottomRight;
+		Point<float> handleLeftTop, handleLeftBottom, handleRightTop, handleRightBottom;
+		bool bezier = false;
+		bool gpuTessellation = false;
+
+		float cropTop = 0, cropRight = 0, cropBottom = 0, cropLeft = 0;
+		FillType fillType = STRETCH;
+		float ratio = 1;
+
+		bool hasMedia = false;
+		Point<int> mediaSize;
+		bool mediaFlipY = false;
+		bool maskFlipY = false;
+
+		Array<PinData> pins; //enabled pins only
+		Point<int> screenSize;
+	};
+
+	std::shared_ptr<const SurfaceGeometry> geometry;
+	SpinLock geometryLock;
+	unsigned int geometryVersion;
+	DelaunayTriangulation pinsTriangulation; //builder thread only
+
+	unsigned int paramsVersion; //bumped when a parameter of the uniform block changes
+	unsigned int alphaVersion; //bumped when the soft edges or the mask change
+
+	int addToVertices(SurfaceGeometry& g, Point<float> posDisplay, Point<float>itnernalCoord, Vector3D<float> texCoord, Vector3D<float> maskCoord);
+	void addLastFourAsQuad(SurfaceGeometry& g);
+	void requestMeshUpdate();
+	MeshInput getMeshInput();
+	void updateVertices(const MeshInput& in); //builder thread
+	std::shared_ptr<const SurfaceGeometry> getGeometry();
+	void fillParams(SurfaceParams& params);
+
+	//GL thread, the media to draw or nullptr if the surface is not drawn, 0 when there is no mask
+	Media* getDrawMedia();
+	GLuint getMaskTextureID();
+
+	void draw(const SurfaceShaderLocations& locations);
+	void drawGeometry(const SurfaceShaderLocations& locations); //mesh and parameters only, textures are bound by the caller
+	void initGL(const SurfaceShaderLocations& locations);
+	void uploadVertices();
+	void uploadParams();
+	void releaseGL();
 
 	Media* getMedia();
 	Point<int> getMediaSize();
 
 	bool isUsingMedia(Media* m) override;
+	OpenGLRenderer* getRenderConsumer() override;
 
 	Array<Point2DParameter*> getCornerHandles();
 	Array<Point2DParameter*> getAllHandles();
@@ -119,9 +211,14 @@ public:
 	String getTypeString() const override { return objectType; }
 	static Surface* create(var params) { return new Surface(params); }
 
+	Screen* getScreen();
+	bool isAlphaPrecomputed(); //mask texture holds the alpha of the surface, see SurfaceAlphaBaker
+	static Point<int> getBezierGridSize(const MeshInput& in);
+
 	static Point<float> getBeziers(Point<float>a, Point<float>b, Point<float>c, Point<float>d, float r);
 	static bool intersection(Point<float> p1, Point<float> p2, Point<float> p3, Point<float> p4, Point<float>* intersect); // should be in another objet
 	static Point<float> openGLPoint(Point2DParameter* p);
+	static Point<float> openGLPoint(Point<float> p);
 	static bool isPointInsideTriangle(Point<float> point, Point<float> vertex1, Point<float> vertex2, Point<float> vertex3);
 	static bool isPointInsideCircumcircle(Point<float> point, Point<float> vertex1, Point<float> vertex2, Point<float> vertex3);
 };
@@ -26,6 +26,7 @@ SurfaceManager::~SurfaceManager()
 
 void SurfaceManager::addItemInternal(Surface* o, var data)
 {
+	if (GlContextHolder::getInstanceWithoutCreating() != nullptr) GlContextHolder::getInstance()->renderGraph.setDirty(); //media links only resolve to a consumer once parented
 }
 
 void SurfaceManager::removeItemInternal(Surface* o)
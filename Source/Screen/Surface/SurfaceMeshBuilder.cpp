@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+	SurfaceMeshBuilder.cpp
+	Created: 17 Oct 2026 7:18:42pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+#include "Screen/ScreenIncludes.h"
+
+juce_ImplementSingleton(SurfaceMeshBuilder)
+
+SurfaceMeshBuilder::SurfaceMeshBuilder() :
+	Thread("Surface Mesh Builder")
+{
+	startThread();
+}
+
+SurfaceMeshBuilder::~SurfaceMeshBuilder()
+{
+	stopThread(3000);
+}
+
+void SurfaceMeshBuilder::requestUpdate(Surface* s, Surface::MeshInput input)
+{
+	//copied outside of the queue lock, the builder only swaps pointers under it
+	std::shared_ptr<const Surface::MeshInput> in = std::make_shared<const Surface::MeshInput>(std::move(input));
+
+	{
+		GenericScopedLock lock(queueLock);
+		bool merged = false;
+		for (auto& r : pendingRequests)
+		{
+			if (r.surface != s) continue;
+			r.input = in;
+			merged = true;
+			break;
+		}
+		if (!merged) pendingRequests.add({ s, in });
+	}
+
+	notify();
+}
+
+void SurfaceMeshBuilder::removeSurface(Surface* s)
+{
+	//wait for a build of this surface to finish before dropping it
+	ScopedLock bl(buildLock);
+	GenericScopedLock lock(queueLock);
+	for (int i = pendingRequests.size() - 1; i >= 0; i--)
+	{
+		if (pendingRequests.getReference(i).surface == s) pendingRequests.remove(i);
+	}
+}
+
+void SurfaceMeshBuilder::run()
+{
+	while (!threadShouldExit())
+	{
+		{
+			ScopedLock bl(buildLock);
+
+			Request r{ nullptr, nullptr };
+			{
+				GenericScopedLock lock(queueLock);
+				if (!pendingRequests.isEmpty()) r = pendingRequests.removeAndReturn(0);
+			}
+
+			if (r.surface != nullptr)
+			{
+				r.surface->updateVertices(*r.input);
+				continue;
+			}
+		}
+
+		wait(100);
+	}
+}
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+	SurfaceMeshBuilder.h
+	Created: 17 Oct 2026 7:18:42pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Builds the meshes of the surfaces away from the GL thread.
+// Surfaces ask for a rebuild when one of their parameters changes, the builder publishes a new immutable
+// SurfaceGeometry when it is done and the renderers pick it up on their next frame, so dragging a handle
+// of a dense bezier or pin surface never stalls the outputs. Each request carries the inputs copied by the
+// surface when it was made, requests for the same surface are merged and keep the latest inputs.
+class SurfaceMeshBuilder :
+	public Thread
+{
+public:
+	juce_DeclareSingleton(SurfaceMeshBuilder, true)
+	SurfaceMeshBuilder();
+	~SurfaceMeshBuilder();
+
+	CriticalSection buildLock; //held while a surface is built, so it can't be deleted under the builder
+	SpinLock queueLock;
+
+	struct Request
+	{
+		Surface* surface;
+		std::shared_ptr<const Surface::MeshInput> input;
+	};
+	Array<Request> pendingRequests;
+
+	void requestUpdate(Surface* s, Surface::MeshInput input);
+	void removeSurface(Surface* s);
+
+	void run() override;
+
+	JUCE_DECLARE_NON_COPYABLE(SurfaceMeshBuilder)
+};
@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+	PresentBarrier.cpp
+	Created: 18 Oct 2026 2:47:19pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Screen/ScreenIncludes.h"
+
+PresentBarrier::PresentBarrier() :
+	numArrived(0),
+	generation(0),
+	minFrame(INT64_MAX),
+	maxFrame(INT64_MIN),
+	lastSpread(0),
+	lockedFrame(-1)
+{
+}
+
+PresentBarrier::~PresentBarrier()
+{
+}
+
+void PresentBarrier::addParticipant(ScreenOutput* o)
+{
+	std::lock_guard<std::mutex> l(lock);
+	participants.addIfNotAlreadyThere(o);
+}
+
+void PresentBarrier::removeParticipant(ScreenOutput* o)
+{
+	std::lock_guard<std::mutex> l(lock);
+	participants.removeFirstMatchingValue(o);
+
+	//the others may only be waiting for this one
+	if (numArrived > 0 && numArrived >= participants.size()) release(maxFrame - minFrame);
+	if (participants.isEmpty()) lockedFrame = -1;
+}
+
+int64 PresentBarrier::arrive(ScreenOutput* o, int64 frameNumber)
+{
+	std::unique_lock<std::mutex> l(lock);
+	if (!participants.contains(o)) return 0;
+
+	numArrived++;
+	minFrame = jmin(minFrame, frameNumber);
+	maxFrame = jmax(maxFrame, frameNumber);
+
+	if (numArrived >= participants.size())
+	{
+		release(maxFrame - minFrame);
+		return lastSpread;
+	}
+
+	const int64 g = generation;
+	if (!released.wait_for(l, std::chrono::milliseconds(maxWaitMs), [this, g] { return generation != g; })) release(-1);
+
+	return lastSpread;
+}
+
+void PresentBarrier::release(int64 spread)
+{
+	lastSpread = spread;
+	numArrived = 0;
+	minFrame = INT64_MAX;
+	maxFrame = INT64_MIN;
+	generation++;
+
+	//next frame for all the outputs, the newest one every screen has
+	int64 frame = INT64_MAX;
+	for (auto& p : participants) frame = jmin(frame, p->screen->renderer->handoff.getLastFrameNumber());
+	lockedFrame = frame == INT64_MAX ? -1 : frame;
+
+	released.notify_all();
+}
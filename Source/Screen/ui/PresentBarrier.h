@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+	PresentBarrier.h
+	Created: 18 Oct 2026 2:47:19pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class ScreenOutput;
+
+// Keeps the frame locked output windows in lockstep. Every output presents the same rendered frame,
+// picked when the previous present was released as the newest frame all their screens have published,
+// and waits before its swap until the others are ready to swap the same frame.
+// An output that doesn't show up in time releases the others, the present is then counted as skewed.
+class PresentBarrier
+{
+public:
+	PresentBarrier();
+	~PresentBarrier();
+
+	static const int maxWaitMs = 50; //a few frames, an output whose window is dragged or hidden can't stall the others longer
+
+	std::mutex lock;
+	std::condition_variable released;
+
+	Array<ScreenOutput*> participants;
+	int numArrived;
+	int64 generation;
+	int64 minFrame;
+	int64 maxFrame;
+	int64 lastSpread;
+	std::atomic<int64> lockedFrame; //-1 when no frame is locked yet, outputs show their newest frame
+
+	//message thread
+	void addParticipant(ScreenOutput* o);
+	void removeParticipant(ScreenOutput* o);
+
+	//output GL threads
+	int64 getLockedFrame() const { return lockedFrame.load(); }
+
+	//returns the spread of the frames presented by the outputs, 0 when in lockstep, -1 on time out
+	int64 arrive(ScreenOutput* o, int64 frameNumber);
+
+private:
+	void release(int64 spread);
+};
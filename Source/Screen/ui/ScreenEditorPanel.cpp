@@ -368,33 +368,18 @@ void ScreenEditorView::renderOpenGL()
 {
 	if (inspectable.wasObjectDeleted()) return;
 
-	OpenGLFrameBuffer* frameBuffer = &screen->renderer->frameBuffer;
+	PooledFrameBuffer* frameBuffer = &screen->renderer->frameBuffer;
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-	Init2DMatrix(getWidth(), getHeight());
+	QuadBatcher& batcher = GlContextHolder::getInstance()->getQuadBatcher();
+	batcher.begin(getWidth(), getHeight());
 
 	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-
-	Colour c = BG_COLOR.darker();
 	//draw BG
-	glBegin(GL_QUADS);
-	glColor3f(c.getFloatRed(), c.getFloatGreen(), c.getFloatBlue());
-	glTexCoord2f(0, 0); glVertex2f(0, 0);
-	glTexCoord2f(0, 1); glVertex2f(0, getHeight());
-	glTexCoord2f(1, 1); glVertex2f(getWidth(), getHeight());
-	glTexCoord2f(1, 0); glVertex2f(getWidth(), 0);
-	glEnd();
-	glGetError();
-
+	batcher.fillRect(Rectangle<float>(0, 0, getWidth(), getHeight()), BG_COLOR.darker());
 
 	//draw frameBuffer
-	glEnable(GL_TEXTURE_2D);
-	glBindTexture(GL_TEXTURE_2D, frameBuffer->getTextureID());
-
-
-
 	int fw = frameBuffer->getWidth();
 	int fh = frameBuffer->getHeight();
 
@@ -420,17 +405,9 @@ void ScreenEditorView::renderOpenGL()
 	float ox = viewOffset.x;
 	float oy = viewOffset.y;
 
+	batcher.drawTexture(frameBuffer->getTextureID(), frameBufferRect.toFloat(), Colours::white, false, Rectangle<float>(ox, oy + hZoom, rZoom, rZoom));
 
-	glBegin(GL_QUADS);
-	glColor3f(1, 1, 1);
-	glTexCoord2f(ox, oy + hZoom); glVertex2f(tx, ty);
-	glTexCoord2f(ox + rZoom, oy + hZoom); glVertex2f(tx + tw, ty);
-	glTexCoord2f(ox + rZoom, oy + 1); glVertex2f(tx + tw, ty + th);
-	glTexCoord2f(ox, oy + 1); glVertex2f(tx, ty + th);
-	glEnd();
-	glGetError();
-
-	glDisable(GL_TEXTURE_2D);
+	batcher.end();
 
 	glDisable(GL_BLEND);
 }
@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+	ScreenNDISender.cpp
+	Created: 18 Oct 2026 4:58:33pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Screen/ScreenIncludes.h"
+#include "Common/CommonIncludes.h"
+
+using namespace juce::gl;
+
+ScreenNDISender::ScreenNDISender() :
+	fbo(0),
+	texture(0),
+	vao(0),
+	vbo(0),
+	droppedFrames(0)
+{
+}
+
+ScreenNDISender::~ScreenNDISender()
+{
+}
+
+void ScreenNDISender::send(GLuint sourceTexture, int width, int height, std::shared_ptr<NDIOutput> output, int fps)
+{
+	//UYVY holds pairs of pixels
+	width &= ~1;
+	if (output == nullptr || sourceTexture == 0 || width <= 0 || height <= 0) return;
+
+	if (shader == nullptr && !initGL()) return;
+	if (!convert(sourceTexture, width, height)) return;
+
+	//the copy is queued right away, the texture can be drawn again next frame. Rows come back top first, flipped by the conversion
+	bool queued = GlContextHolder::getInstance()->readback.request(texture, Rectangle<int>(0, 0, width / 2, height), GPUReadback::RGBA,
+		[output, width, height, fps](const GPUReadback::Result& r)
+		{
+			if (r.data != nullptr) output->pushFrame(r.data, width, height, fps);
+		});
+
+	//the GPU or the sender can't keep up
+	if (!queued) droppedFrames++;
+}
+
+bool ScreenNDISender::convert(GLuint sourceTexture, int width, int height)
+{
+	const Point<int> size(width / 2, height);
+	if (textureSize != size)
+	{
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		textureSize = size;
+	}
+
+	GLint previousFBO = 0;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFBO);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+
+	bool result = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+	if (result)
+	{
+		glViewport(0, 0, size.x, size.y);
+		glDisable(GL_BLEND);
+
+		shader->use();
+		shader->setUniform("sourceSize", (GLfloat)width, (GLfloat)height);
+
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, sourceTexture);
+
+		glBindVertexArray(vao);
+		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+		glBindVertexArray(0);
+
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glUseProgram(0);
+		glEnable(GL_BLEND);
+	}
+	else
+	{
+		LOGERROR("Screen NDI sender : could not convert the frame");
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
+	glGetError();
+
+	return result;
+}
+
+bool ScreenNDISender::initGL()
+{
+	const String vertexShader = R"(
+		attribute vec2 position;
+
+		void main()
+		{
+			gl_Position = vec4(position, 0.0, 1.0);
+		}
+	)";
+
+	//each texel packs 2 source pixels as U Y0 V Y1, BT.709 video range, rows flipped so the readback starts at the top
+	const String fragmentShader = R"(
+		uniform sampler2D source;
+		uniform vec2 sourceSize;
+
+		vec3 toYUV(vec3 c)
+		{
+			float y = dot(c, vec3(0.2126, 0.7152, 0.0722));
+			float u = dot(c, vec3(-0.1146, -0.3854, 0.5));
+			float v = dot(c, vec3(0.5, -0.4542, -0.0458));
+			return vec3(16.0 + y * 219.0, 128.0 + u * 224.0, 128.0 + v * 224.0) / 255.0;
+		}
+
+		void main()
+		{
+			float x = floor(gl_FragCoord.x) * 2.0 + 0.5;
+			float y = sourceSize.y - gl_FragCoord.y;
+
+			vec3 a = toYUV(texture2D(source, vec2(x, y) / sourceSize).rgb);
+			vec3 b = toYUV(texture2D(source, vec2(x + 1.0, y) / sourceSize).rgb);
+
+			gl_FragColor = vec4((a.y + b.y) * 0.5, a.x, (a.z + b.z) * 0.5, b.x);
+		}
+	)";
+
+	shader.reset(new OpenGLShaderProgram(GlContextHolder::getInstance()->getCurrentContext()));
+	if (!shader->addVertexShader(OpenGLHelpers::translateVertexShaderToV3(vertexShader))
+		|| !shader->addFragmentShader(OpenGLHelpers::translateFragmentShaderToV3(fragmentShader))
+		|| !shader->link())
+	{
+		LOGERROR("Screen NDI sender : error compiling shader : " << shader->getLastError());
+		shader.reset();
+		return false;
+	}
+
+	shader->use();
+	shader->setUniform("source", 0);
+	glUseProgram(0);
+
+	//fullscreen quad
+	const GLfloat quad[8] = { -1, -1, 1, -1, -1, 1, 1, 1 };
+
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+
+	GLint posAttrib = glGetAttribLocation(shader->getProgramID(), "position");
+	glEnableVertexAttribArray(posAttrib);
+	glVertexAttribPointer(posAttrib, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), 0);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glGenFramebuffers(1, &fbo);
+	glGenTextures(1, &texture);
+
+	return true;
+}
+
+void ScreenNDISender::release()
+{
+	if (fbo != 0) glDeleteFramebuffers(1, &fbo);
+	if (texture != 0) glDeleteTextures(1, &texture);
+	if (vao != 0) glDeleteVertexArrays(1, &vao);
+	if (vbo != 0) glDeleteBuffers(1, &vbo);
+	shader.reset();
+
+	fbo = 0;
+	texture = 0;
+	textureSize = Point<int>();
+	vao = 0;
+	vbo = 0;
+}
@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+	ScreenNDISender.h
+	Created: 18 Oct 2026 4:58:33pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Reads the frames of a screen back for its NDI output without stalling the GL thread.
+// Each frame is converted to UYVY on the GPU, packing 2 pixels in one RGBA texel so the readback is half the size,
+// then read back asynchronously by the GPUReadback of the context holder, which hands it to the NDIOutput.
+class ScreenNDISender
+{
+public:
+	ScreenNDISender();
+	~ScreenNDISender();
+
+	GLuint fbo;
+	GLuint texture;
+	Point<int> textureSize;
+	GLuint vao;
+	GLuint vbo;
+	std::unique_ptr<OpenGLShaderProgram> shader;
+	int droppedFrames;
+
+	//GL thread, outside of any render target
+	void send(GLuint sourceTexture, int width, int height, std::shared_ptr<NDIOutput> output, int fps);
+	void release();
+
+private:
+	bool initGL();
+	bool convert(GLuint sourceTexture, int width, int height);
+};
@@ -15,11 +15,21 @@ juce_ImplementSingleton(ScreenOutputWatcher)
 
 using namespace juce::gl;
 
-ScreenOutput::ScreenOutput(Screen* screen) :
+ScreenOutput::ScreenOutput(Screen* screen, PresentBarrier* barrier) :
 	InspectableContentComponent(screen),
 	isLive(false),
-	screen(screen)
+	isFrameLocked(false),
+	screen(screen),
+	barrier(barrier),
+	quadBatcher(openGLContext),
+	swapInterval(-1),
+	numFences(0),
+	hasPendingPresent(false),
+	pendingFrameNumber(-1),
+	pendingFrameTime(0)
 {
+	for (int i = 0; i < maxFenceCount; i++) frameFences[i] = nullptr;
+
 	setOpaque(true);
 
 	autoDrawContourWhenSelected = false;
@@ -38,6 +48,7 @@ ScreenOutput::ScreenOutput(Screen* screen) :
 
 ScreenOutput::~ScreenOutput()
 {
+	barrier->removeParticipant(this);
 	removeFromDesktop();
 	openGLContext.detach();
 }
@@ -68,12 +79,12 @@ void ScreenOutput::update()
 
 		if (!prevIsLive)
 		{
-			startTimerHz(60);
-			//openGLContext.setContinuousRepainting(true);
 			addToDesktop(0);
 			setAlwaysOnTop(true);
 		}
 
+		updateRepaintMode();
+
 		Rectangle<int> a = d.totalArea;
 		a.setWidth(a.getWidth());
 		a.setHeight(a.getHeight() - 1); // -1 to stop my screen to flicker ><
@@ -86,7 +97,7 @@ void ScreenOutput::update()
 		{
 			removeFromDesktop();
 			stopTimer();
-			//openGLContext.setContinuousRepainting(false);
+			openGLContext.setContinuousRepainting(false);
 			setAlwaysOnTop(false);
 		}
 
@@ -94,6 +105,29 @@ void ScreenOutput::update()
 	}
 
 	setVisible(shouldShow);
+
+	bool shouldLock = isLive && screen->frameLock->boolValue();
+	if (shouldLock != isFrameLocked)
+	{
+		isFrameLocked = shouldLock;
+		if (isFrameLocked) barrier->addParticipant(this);
+		else barrier->removeParticipant(this);
+	}
+}
+
+void ScreenOutput::updateRepaintMode()
+{
+	//the swap interval itself is set on the render thread, where the context is active
+	if (screen->syncToDisplay->boolValue())
+	{
+		stopTimer();
+		openGLContext.setContinuousRepainting(true);
+	}
+	else
+	{
+		openGLContext.setContinuousRepainting(false);
+		startTimerHz(60);
+	}
 }
 
 void ScreenOutput::newOpenGLContextCreated()
@@ -115,30 +149,103 @@ void ScreenOutput::renderOpenGL()
 	}
 	openGLContext.makeActive();
 
+	const bool sync = screen->syncToDisplay->boolValue();
+	if (swapInterval != (sync ? 1 : 0))
+	{
+		swapInterval = sync ? 1 : 0;
+		openGLContext.setSwapInterval(swapInterval);
+		screen->presentTimer.reset();
+		hasPendingPresent = false;
+	}
+
+	//synced, the previous swap returned on the vertical sync, which is when it was presented
+	double now = Time::getMillisecondCounterHiRes();
+	if (sync && hasPendingPresent) screen->presentTimer.presented(now, pendingFrameNumber, pendingFrameTime);
+	hasPendingPresent = false;
+
+	//fence the previous frame, its swap included, and wait for the GPU to catch up before queuing another
+	waitForFramesInFlight(screen->maxFramesInFlight->intValue());
+
 	Init2DViewport(getWidth(), getHeight());
 
 	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT);
 
-	glEnable(GL_TEXTURE_2D);
-	glBindTexture(GL_TEXTURE_2D, screen->renderer->frameBuffer.getTextureID());
-
 	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-	glBegin(GL_QUADS);
-	glColor3f(1, 1, 1);
-	glTexCoord2f(0, 0); glVertex2f(0, 0);
-	glTexCoord2f(0, 1); glVertex2f(0, getHeight());
-	glTexCoord2f(1, 1); glVertex2f(getWidth(), getHeight());
-	glTexCoord2f(1, 0); glVertex2f(getWidth(), 0);
-	glEnd();
+	//last completed frame of the screen, never one the main thread is still drawing
+	//frame locked, the frame picked for all the locked outputs
+	const bool locked = isFrameLocked;
+
+	int64 frameNumber = -1;
+	double frameTime = 0;
+	GLuint texID = screen->renderer->handoff.getTextureID(frameNumber, frameTime, locked ? barrier->getLockedFrame() : -1);
 
-	glDisable(GL_TEXTURE_2D);
+	//nothing handed off yet, stay black rather than sampling the render target the main thread draws into
+	if (texID != 0)
+	{
+		quadBatcher.begin(getWidth(), getHeight());
+		quadBatcher.drawTexture(texID, Rectangle<float>(0, 0, getWidth(), getHeight()));
+		quadBatcher.end();
+	}
+	FrameHandoff::readerFrameDone();
+
+	//the swap follows this call, wait for the other locked outputs to be ready to swap too
+	if (locked)
+	{
+		glFlush();
+		screen->presentTimer.addSkew(barrier->arrive(this, frameNumber));
+	}
+
+	//not synced, the swap following this call returns without waiting and presents right away
+	if (sync)
+	{
+		hasPendingPresent = true;
+		pendingFrameNumber = frameNumber;
+		pendingFrameTime = frameTime;
+	}
+	else
+	{
+		screen->presentTimer.presented(Time::getMillisecondCounterHiRes(), frameNumber, frameTime);
+	}
+}
+
+void ScreenOutput::waitForFramesInFlight(int maxFrames)
+{
+	GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	if (fence == nullptr) return;
+
+	if (numFences == maxFenceCount)
+	{
+		glDeleteSync(frameFences[0]);
+		for (int i = 1; i < numFences; i++) frameFences[i - 1] = frameFences[i];
+		numFences--;
+	}
+	frameFences[numFences++] = fence;
+
+	//oldest first, the flush makes sure the fence can signal
+	while (numFences > 0 && numFences >= maxFrames)
+	{
+		glClientWaitSync(frameFences[0], GL_SYNC_FLUSH_COMMANDS_BIT, 100000000); //100ms, never hang the render thread on a lost context
+		glDeleteSync(frameFences[0]);
+		for (int i = 1; i < numFences; i++) frameFences[i - 1] = frameFences[i];
+		numFences--;
+	}
+}
+
+void ScreenOutput::releaseFences()
+{
+	for (int i = 0; i < numFences; i++) glDeleteSync(frameFences[i]);
+	numFences = 0;
 }
 
 void ScreenOutput::openGLContextClosing()
 {
+	FrameHandoff::readerFrameDone();
+	releaseFences();
+	quadBatcher.release();
+	swapInterval = -1;
+	hasPendingPresent = false;
 }
 
 void ScreenOutput::userTriedToCloseWindow()
@@ -184,7 +291,7 @@ void ScreenOutputWatcher::updateOutput(Screen* s, bool forceRemove)
 	bool shouldShow = !forceRemove && !s->isClearing && s->enabled->boolValue() && s->outputType->getValueDataAsEnum<Screen::OutputType>() == Screen::OutputType::DISPLAY;
 	if (o == nullptr)
 	{
-		if (shouldShow) outputs.add(new ScreenOutput(s));
+		if (shouldShow) outputs.add(new ScreenOutput(s, &presentBarrier));
 	}
 	else
 	{
@@ -257,7 +364,7 @@ void ScreenOutputWatcher::newMessage(const ContainerAsyncEvent& e)
 	{
 		if (Screen* s = dynamic_cast<Screen*>(e.targetControllable->parentContainer.get()))
 		{
-			if (e.targetControllable == s->enabled || e.targetControllable == s->outputType || e.targetControllable == s->screenID)
+			if (e.targetControllable == s->enabled || e.targetControllable == s->outputType || e.targetControllable == s->screenID || e.targetControllable == s->syncToDisplay || e.targetControllable == s->frameLock)
 			{
 				updateOutput(s);
 			}
@@ -13,6 +13,11 @@
 class Screen;
 class Media;
 
+// Window showing a screen on a display, with its own context and render thread.
+// When synced to the display, the context repaints continuously and its buffer swap waits for the vertical sync,
+// so each present follows the display refresh. Otherwise a timer triggers repaints at 60 fps.
+// Fences on the presented frames keep at most the screen's max frames in flight queued on the GPU.
+// Frame locked outputs present together through the PresentBarrier of the ScreenOutputWatcher.
 class ScreenOutput :
 	public InspectableContentComponent,
 	public OpenGLRenderer,
@@ -20,16 +25,30 @@ class ScreenOutput :
 	public Timer
 {
 public:
-	ScreenOutput(Screen* parent);
+	ScreenOutput(Screen* parent, PresentBarrier* barrier);
 	~ScreenOutput();
 
 	Screen* screen;
+	PresentBarrier* barrier;
+
+	static const int maxFenceCount = 3;
 
 	bool isLive;
+	bool isFrameLocked;
 	juce::OpenGLContext openGLContext;
-	
+	QuadBatcher quadBatcher;
+
+	//GL thread
+	int swapInterval; //-1 until set on the context
+	GLsync frameFences[maxFenceCount];
+	int numFences;
+	bool hasPendingPresent;
+	int64 pendingFrameNumber;
+	double pendingFrameTime;
+
 	void paint(Graphics& g) override {}
 	void update();
+	void updateRepaintMode();
 
 	void newOpenGLContextCreated() override;
 	void renderOpenGL() override;
@@ -40,6 +59,10 @@ public:
 	void userTriedToCloseWindow() override;
 
 	bool keyPressed(const KeyPress& key, Component* originatingComponent);
+
+private:
+	void waitForFramesInFlight(int maxFrames);
+	void releaseFences();
 };
 
 
@@ -54,6 +77,7 @@ public:
 	ScreenOutputWatcher();
 	~ScreenOutputWatcher();
 
+	PresentBarrier presentBarrier; //declared first, outlives the outputs
 	OwnedArray<ScreenOutput> outputs;
 
 	void updateOutput(Screen* s, bool forceRemove = false);
@@ -16,8 +16,7 @@
 using namespace juce::gl;
 
 ScreenRenderer::ScreenRenderer(Screen* screen) :
-	screen(screen),
-	timeAtLastRender(0)
+	screen(screen)
 {
 	GlContextHolder::getInstance()->registerOpenGlRenderer(this);
 }
@@ -31,15 +30,27 @@ void ScreenRenderer::newOpenGLContextCreated()
 {
 	// Set up your OpenGL state here
 	createAndLoadShaders();
-	frameBuffer.initialise(GlContextHolder::getInstance()->context, screen->screenWidth->intValue(), screen->screenHeight->intValue());
+	initFrameBuffer();
 }
 
 void ScreenRenderer::renderOpenGL()
 {
-	const double frameTime = 1000.0 / RMPSettings::getInstance()->fpsLimit->intValue();
-	double t = GlContextHolder::getInstance()->timeAtRender;
-	if (t < timeAtLastRender + frameTime) return;
-	timeAtLastRender = t;
+	GlContextHolder* holder = GlContextHolder::getInstance();
+	if (!holder->frameScheduler.shouldRender(renderSlot)) return;
+
+	//production frames before this one are complete, the medias drawn below come from them at the latest
+	const int64 mainTick = holder->frameScheduler.numTicks;
+	const int64 productionTick = holder->hasProductionThread() ? holder->production->frameScheduler.numTicks.load() : -1;
+	screen->renderTimer.setMissedDeadlines(renderSlot.missedDeadlines);
+
+	screen->renderTimer.begin();
+
+	if (frameBuffer.getWidth() != screen->screenWidth->intValue() || frameBuffer.getHeight() != screen->screenHeight->intValue()) initFrameBuffer();
+
+	alphaBaker.update(screen);
+
+	const bool useWarpMap = screen->bakeWarpMap->boolValue() && bakeShader != nullptr;
+	if (useWarpMap) warpMap.bake(screen, bakeShader.get(), bakeShaderLocations);
 
 	frameBuffer.makeCurrentRenderingTarget();
 	glClearColor(0, 0, 0, 1.0f);
@@ -51,14 +62,25 @@ void ScreenRenderer::renderOpenGL()
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 
-	if (shader != nullptr)
+	if (useWarpMap)
 	{
+		warpMap.draw();
+	}
+	else if (screen->batchSurfaces->boolValue() && batchShader != nullptr)
+	{
+		batchShader->use();
+		surfaceBatch.draw(screen, batchShaderLocations);
+		glUseProgram(0);
+	}
+	else if (shader != nullptr)
+	{
+		shader->use();
 
 		for (auto& s : screen->surfaces.items)
 		{
-			shader->use();
-			GLuint shaderProgram = shader->getProgramID();
-			s->draw(shaderProgram);
+			s->renderTimer.begin();
+			s->draw(shaderLocations);
+			s->renderTimer.end();
 		}
 
 		glUseProgram(0);
@@ -76,6 +98,17 @@ void ScreenRenderer::renderOpenGL()
 
 	frameBuffer.releaseAsRenderingTarget();
 
+	screen->recorder.frameRendered(frameBuffer, mainTick, productionTick);
+
+	Screen::OutputType outputType = screen->outputType->getValueDataAsEnum<Screen::OutputType>();
+	if (outputType == Screen::OutputType::DISPLAY) handoff.publish(frameBuffer, GlContextHolder::getInstance()->frameScheduler.numTicks);
+	else if (outputType == Screen::OutputType::NDI)
+	{
+		std::shared_ptr<NDIOutput> ndiOutput = screen->getNDIOutput();
+		ndiSender.send(frameBuffer.getTextureID(), frameBuffer.getWidth(), frameBuffer.getHeight(), ndiOutput, GlContextHolder::getInstance()->frameScheduler.globalFPS);
+	}
+
+	screen->renderTimer.end();
 }
 
 void ScreenRenderer::openGLContextClosing()
@@ -83,13 +116,82 @@ void ScreenRenderer::openGLContextClosing()
 	glEnable(GL_BLEND);
 	glDisable(GL_BLEND);
 	shader = nullptr;
+	batchShader = nullptr;
+	bakeShader = nullptr;
+	surfaceBatch.release();
+	warpMap.release();
+	alphaBaker.release();
+	handoff.release();
+	ndiSender.release();
+	frameBuffer.release();
+
+	screen->renderTimer.release();
+	for (auto& s : screen->surfaces.items)
+	{
+		s->renderTimer.release();
+		s->releaseGL();
+	}
 }
 
 
+void ScreenRenderer::initFrameBuffer()
+{
+	if (!frameBuffer.initialise(screen->screenWidth->intValue(), screen->screenHeight->intValue())) return;
+
+	//the pooled buffer may have moved
+	if (screen->sharedTextureSender != nullptr) screen->sharedTextureSender->setExternalFBO(frameBuffer.get());
+}
+
 void ScreenRenderer::createAndLoadShaders()
 {
-	shader.reset(new OpenGLShaderProgram(GlContextHolder::getInstance()->context));
-	shader->addVertexShader(OpenGLHelpers::translateVertexShaderToV3(BinaryData::VertexShaderMainSurface_glsl));
-	shader->addFragmentShader(OpenGLHelpers::translateFragmentShaderToV3(BinaryData::fragmentShaderMainSurface_glsl));
-	shader->link();
-}
\ No newline at end of file
+	shader.reset(createSurfaceShader(String(), shaderLocations));
+
+	String batchDefines = "#define SURFACE_BATCH\n#define MAX_SURFACES " + String(SurfaceBatch::maxSurfacesPerBlock) + "\n";
+	batchShader.reset(createSurfaceShader(batchDefines, batchShaderLocations));
+
+	bakeShader.reset(createSurfaceShader("#define SURFACE_BAKE\n", bakeShaderLocations));
+}
+
+OpenGLShaderProgram* ScreenRenderer::createSurfaceShader(const String& defines, SurfaceShaderLocations& locations)
+{
+	std::unique_ptr<OpenGLShaderProgram> program(new OpenGLShaderProgram(GlContextHolder::getInstance()->getCurrentContext()));
+	program->addVertexShader(OpenGLHelpers::translateVertexShaderToV3(defines + BinaryData::VertexShaderMainSurface_glsl));
+	program->addFragmentShader(OpenGLHelpers::translateFragmentShaderToV3(defines + BinaryData::fragmentShaderMainSurface_glsl));
+
+	//same attribute layout in every variant, so a surface VAO works with all of them
+	GLuint programID = program->getProgramID();
+	glBindAttribLocation(programID, 0, "position");
+	glBindAttribLocation(programID, 1, "surfacePosition");
+	glBindAttribLocation(programID, 2, "texcoord");
+	glBindAttribLocation(programID, 3, "maskcoord");
+	glBindAttribLocation(programID, 4, "surfaceIndex");
+	glBindFragDataLocation(programID, 0, "outColor");
+	glBindFragDataLocation(programID, 1, "outWarpMask"); //baked variant only
+
+	if (!program->link())
+	{
+		NLOGERROR(screen->niceName, "Surface shader link failed: " << program->getLastError());
+		return nullptr;
+	}
+
+	locations.position = glGetAttribLocation(programID, "position");
+	locations.surfacePosition = glGetAttribLocation(programID, "surfacePosition");
+	locations.texcoord = glGetAttribLocation(programID, "texcoord");
+	locations.maskcoord = glGetAttribLocation(programID, "maskcoord");
+	locations.surfaceIndex = glGetAttribLocation(programID, "surfaceIndex");
+
+	//samplers and the parameter block never move, surfaces only bind their textures and uniform buffer
+	program->use();
+	glUniform1i(glGetUniformLocation(programID, "mask"), 0);
+	glUniform1i(glGetUniformLocation(programID, "tex"), 1);
+
+	GLuint paramsIndex = glGetUniformBlockIndex(programID, "SurfaceParams");
+	if (paramsIndex != GL_INVALID_INDEX) glUniformBlockBinding(programID, paramsIndex, Surface::paramsBindingPoint);
+
+	GLuint batchParamsIndex = glGetUniformBlockIndex(programID, "SurfaceBatchParams");
+	if (batchParamsIndex != GL_INVALID_INDEX) glUniformBlockBinding(programID, batchParamsIndex, SurfaceBatch::paramsBindingPoint);
+
+	glUseProgram(0);
+
+	return program.release();
+}
@@ -21,14 +21,26 @@ public:
 	Screen* screen;
 
 	std::unique_ptr<OpenGLShaderProgram> shader;
-	juce::OpenGLFrameBuffer frameBuffer;
-
-	long timeAtLastRender;
+	SurfaceShaderLocations shaderLocations;
+	std::unique_ptr<OpenGLShaderProgram> batchShader;
+	SurfaceShaderLocations batchShaderLocations;
+	SurfaceBatch surfaceBatch;
+	std::unique_ptr<OpenGLShaderProgram> bakeShader;
+	SurfaceShaderLocations bakeShaderLocations;
+	WarpMap warpMap;
+	SurfaceAlphaBaker alphaBaker;
+	PooledFrameBuffer frameBuffer;
+	FrameHandoff handoff; //completed frames for the output window, which renders on its own thread
+	ScreenNDISender ndiSender;
+
+	FrameScheduler::Slot renderSlot;
 
 	void newOpenGLContextCreated() override;
 	void renderOpenGL() override;
 
 	void openGLContextClosing() override;
 
+	void initFrameBuffer();
 	void createAndLoadShaders();
+	OpenGLShaderProgram* createSurfaceShader(const String& defines, SurfaceShaderLocations& locations);
 };
\ No newline at end of file
@@ -0,0 +1,304 @@
+/*
+  ==============================================================================
+
+	SurfaceAlphaBaker.cpp
+	Created: 17 Oct 2026 10:37:16pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Screen/ScreenIncludes.h"
+#include "Common/CommonIncludes.h"
+#include "Media/MediaIncludes.h"
+
+using namespace juce::gl;
+
+SurfaceAlphaBaker::SurfaceAlphaBaker() :
+	fbo(0),
+	vao(0),
+	vbo(0),
+	bakedBlendGamma(0),
+	blendVersion(0)
+{
+}
+
+SurfaceAlphaBaker::~SurfaceAlphaBaker()
+{
+}
+
+void SurfaceAlphaBaker::update(Screen* screen)
+{
+	updateBlendMaps(screen);
+
+	for (auto& s : screen->surfaces.items)
+	{
+		if (!s->enabled->boolValue() || !s->isAlphaPrecomputed()) continue;
+
+		Media* maskMedia = s->mask->getTargetContainerAs<Media>();
+		GLuint maskTexture = maskMedia != nullptr ? maskMedia->getTextureID() : 0;
+		int64 maskFrame = maskMedia != nullptr ? maskMedia->renderedFrames.load() : -1;
+
+		//a moving mask renders new frames and is baked each frame, still ones only once.
+		//Its texture may stay the same, without the production thread it is always the media's frame buffer
+		if (s->alphaTexture != 0 && s->bakedAlphaVersion == s->alphaVersion && s->bakedAlphaMask == maskTexture && s->bakedAlphaMaskFrame == maskFrame && s->bakedBlendVersion == blendVersion) continue;
+
+		if (shader == nullptr && !initGL()) return;
+		bake(s, maskMedia, maskTexture);
+		s->bakedAlphaMaskFrame = maskFrame;
+	}
+}
+
+void SurfaceAlphaBaker::bake(Surface* s, Media* maskMedia, GLuint maskTexture)
+{
+	Point<int> size(defaultSize, defaultSize);
+	if (maskMedia != nullptr)
+	{
+		Point<int> ms = maskMedia->getMediaSize();
+		if (ms.x > 0 && ms.y > 0) size.setXY(jmin(ms.x, (int)maxSize), jmin(ms.y, (int)maxSize));
+	}
+
+	if (s->alphaTexture == 0 || s->alphaTextureSize != size)
+	{
+		if (s->alphaTexture == 0) glGenTextures(1, &s->alphaTexture);
+		glBindTexture(GL_TEXTURE_2D, s->alphaTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		s->alphaTextureSize = size;
+	}
+
+	GLint previousFBO = 0;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFBO);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, s->alphaTexture, 0);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE)
+	{
+		glViewport(0, 0, size.x, size.y);
+		glDisable(GL_BLEND);
+
+		shader->use();
+		shader->setUniform("borderSoft", s->softEdgeTop->floatValue(), s->softEdgeRight->floatValue(), s->softEdgeBottom->floatValue(), s->softEdgeLeft->floatValue());
+		shader->setUniform("invertMask", s->invertMask->boolValue() ? 1.0f : 0.0f);
+		shader->setUniform("flipMask", maskMedia != nullptr && maskMedia->flipY ? 1.0f : 0.0f);
+
+		GLuint white = GlContextHolder::getInstance()->getWhiteTextureID();
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, s->blendTexture != 0 ? s->blendTexture : white);
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, maskTexture != 0 ? maskTexture : white);
+
+		glBindVertexArray(vao);
+		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+		glBindVertexArray(0);
+
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glUseProgram(0);
+		glEnable(GL_BLEND);
+	}
+	else
+	{
+		NLOGERROR(s->niceName, "Could not render the precomputed mask");
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
+	glGetError();
+
+	//marked as baked even on failure, so it is not retried every frame
+	s->bakedAlphaVersion = s->alphaVersion;
+	s->bakedAlphaMask = maskTexture;
+	s->bakedBlendVersion = blendVersion;
+}
+
+void SurfaceAlphaBaker::updateBlendMaps(Screen* screen)
+{
+	blendRegions.clearQuick();
+	const float gamma = screen->blendGamma->floatValue();
+
+	if (screen->autoBlend->boolValue())
+	{
+		for (auto& s : screen->surfaces.items)
+		{
+			if (!s->enabled->boolValue()) continue;
+
+			Media* m = s->getMedia();
+			if (m == nullptr) continue;
+
+			Rectangle<float> crop = Rectangle<float>::leftTopRightBottom(s->cropLeft->floatValue(), s->cropBottom->floatValue(), 1 - s->cropRight->floatValue(), 1 - s->cropTop->floatValue());
+			blendRegions.add({ s, m, crop });
+		}
+	}
+
+	if (blendRegions == bakedBlendRegions && gamma == bakedBlendGamma) return;
+	bakedBlendRegions = blendRegions;
+	bakedBlendGamma = gamma;
+	blendVersion++;
+
+	//weight of a region at a media position, 0 outside of it
+	auto getWeight = [](const Rectangle<float>& r, Point<float> p)
+		{
+			if (p.x <= r.getX() || p.x >= r.getRight() || p.y <= r.getY() || p.y >= r.getBottom()) return 0.0f;
+			return jmin(p.x - r.getX(), r.getRight() - p.x, p.y - r.getY(), r.getBottom() - p.y);
+		};
+
+	HeapBlock<uint8> pixels(blendSize * blendSize);
+	Array<Rectangle<float>> overlaps;
+
+	for (auto& s : screen->surfaces.items)
+	{
+		int index = -1;
+		for (int i = 0; i < blendRegions.size() && index == -1; i++) if (blendRegions[i].surface == s) index = i;
+
+		overlaps.clearQuick();
+		if (index != -1)
+		{
+			const BlendRegion& region = blendRegions.getReference(index);
+			for (auto& other : blendRegions)
+			{
+				if (other.surface != s && other.media == region.media && other.crop.intersects(region.crop)) overlaps.add(other.crop);
+			}
+		}
+
+		//nothing to blend with, the surface keeps the white texture
+		if (overlaps.isEmpty())
+		{
+			if (s->blendTexture != 0) glDeleteTextures(1, &s->blendTexture);
+			s->blendTexture = 0;
+			continue;
+		}
+
+		const Rectangle<float>& crop = blendRegions.getReference(index).crop;
+		for (int y = 0; y < blendSize; y++)
+		{
+			for (int x = 0; x < blendSize; x++)
+			{
+				//texel center in surface coordinates, then in the media
+				Point<float> p(crop.getX() + crop.getWidth() * (x + .5f) / blendSize, crop.getY() + crop.getHeight() * (y + .5f) / blendSize);
+
+				float weight = getWeight(crop, p);
+				float sum = weight;
+				for (auto& o : overlaps) sum += getWeight(o, p);
+
+				float blend = sum > 0 ? weight / sum : 1;
+				pixels[y * blendSize + x] = (uint8)roundToInt(std::pow(blend, 1 / gamma) * 255);
+			}
+		}
+
+		if (s->blendTexture == 0)
+		{
+			glGenTextures(1, &s->blendTexture);
+			glBindTexture(GL_TEXTURE_2D, s->blendTexture);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		}
+		else glBindTexture(GL_TEXTURE_2D, s->blendTexture);
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, blendSize, blendSize, 0, GL_RED, GL_UNSIGNED_BYTE, pixels.get());
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+}
+
+bool SurfaceAlphaBaker::initGL()
+{
+	const String vertexShader = R"(
+		attribute vec2 position;
+
+		varying vec2 surfaceCoord;
+
+		void main()
+		{
+			surfaceCoord = position * 0.5 + 0.5;
+			gl_Position = vec4(position, 0.0, 1.0);
+		}
+	)";
+
+	//same soft edges and mask as the surface shader
+	const String fragmentShader = R"(
+		varying vec2 surfaceCoord;
+
+		uniform sampler2D mask;
+		uniform sampler2D blend;
+		uniform vec4 borderSoft;
+		uniform float invertMask;
+		uniform float flipMask;
+
+		float edge(float value, float from, float to)
+		{
+			return clamp((value - from) / (to - from), 0.0, 1.0);
+		}
+
+		void main()
+		{
+			float alpha = 1.0;
+			if (borderSoft.x > 0.0) alpha *= edge(surfaceCoord.y, 1.0, 1.0 - borderSoft.x);
+			if (borderSoft.y > 0.0) alpha *= edge(surfaceCoord.x, 1.0, 1.0 - borderSoft.y);
+			if (borderSoft.z > 0.0) alpha *= edge(surfaceCoord.y, 0.0, borderSoft.z);
+			if (borderSoft.w > 0.0) alpha *= edge(surfaceCoord.x, 0.0, borderSoft.w);
+
+			vec2 maskCoord = vec2(surfaceCoord.x, flipMask > 0.5 ? 1.0 - surfaceCoord.y : surfaceCoord.y);
+			float maskValue = texture2D(mask, maskCoord).g;
+			if (invertMask > 0.5) maskValue = 1.0 - maskValue;
+
+			gl_FragColor = vec4(alpha * maskValue * texture2D(blend, surfaceCoord).r);
+		}
+	)";
+
+	shader.reset(new OpenGLShaderProgram(GlContextHolder::getInstance()->getCurrentContext()));
+	if (!shader->addVertexShader(OpenGLHelpers::translateVertexShaderToV3(vertexShader))
+		|| !shader->addFragmentShader(OpenGLHelpers::translateFragmentShaderToV3(fragmentShader))
+		|| !shader->link())
+	{
+		LOGERROR("Surface alpha baker : error compiling shader : " << shader->getLastError());
+		shader.reset();
+		return false;
+	}
+
+	shader->use();
+	shader->setUniform("mask", 0);
+	shader->setUniform("blend", 1);
+	glUseProgram(0);
+
+	//fullscreen quad
+	const GLfloat quad[8] = { -1, -1, 1, -1, -1, 1, 1, 1 };
+
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+
+	GLint posAttrib = glGetAttribLocation(shader->getProgramID(), "position");
+	glEnableVertexAttribArray(posAttrib);
+	glVertexAttribPointer(posAttrib, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), 0);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glGenFramebuffers(1, &fbo);
+
+	return true;
+}
+
+void SurfaceAlphaBaker::release()
+{
+	if (fbo != 0) glDeleteFramebuffers(1, &fbo);
+	if (vao != 0) glDeleteVertexArrays(1, &vao);
+	if (vbo != 0) glDeleteBuffers(1, &vbo);
+	shader.reset();
+
+	fbo = 0;
+	vao = 0;
+	vbo = 0;
+}
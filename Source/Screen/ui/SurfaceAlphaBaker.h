@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+	SurfaceAlphaBaker.h
+	Created: 17 Oct 2026 10:37:16pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Renders the alpha of the surfaces using "Precompute mask" : soft edges x mask x inversion, in surface coordinates,
+// into a texture owned by the surface. The surface shader then reads it in place of the mask with one lookup.
+// A surface is baked again when its soft edges or mask parameters change, or when its mask media gives a new texture.
+//
+// With "Auto blend" on the screen, every surface is precomputed and its alpha also holds the blend ramps of the
+// regions it shares with the other surfaces cropping the same media : each surface weighs by its distance to the
+// border of its crop, normalized by the sum of the weights, then gamma corrected so overlaps add up to one in light.
+class SurfaceAlphaBaker
+{
+public:
+	SurfaceAlphaBaker();
+	~SurfaceAlphaBaker();
+
+	static const int defaultSize = 256; //soft edges only, bilinear filtering does the rest
+	static const int maxSize = 4096;
+	static const int blendSize = 128; //ramps are close to linear, computed on the CPU
+
+	struct BlendRegion
+	{
+		Surface* surface;
+		Media* media;
+		Rectangle<float> crop; //part of the media shown by the surface, y up
+
+		bool operator==(const BlendRegion& o) const { return surface == o.surface && media == o.media && crop == o.crop; }
+	};
+
+	GLuint fbo;
+	GLuint vao;
+	GLuint vbo;
+	std::unique_ptr<OpenGLShaderProgram> shader;
+
+	Array<BlendRegion> blendRegions;
+	Array<BlendRegion> bakedBlendRegions;
+	float bakedBlendGamma;
+	unsigned int blendVersion;
+
+	//GL thread, outside of any render target
+	void update(Screen* screen);
+	void release();
+
+private:
+	bool initGL();
+	void updateBlendMaps(Screen* screen);
+	void bake(Surface* s, Media* maskMedia, GLuint maskTexture);
+};
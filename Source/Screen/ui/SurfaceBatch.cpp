@@ -0,0 +1,327 @@
+/*
+  ==============================================================================
+
+	SurfaceBatch.cpp
+	Created: 17 Oct 2026 3:12:54pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Screen/ScreenIncludes.h"
+#include "Media/MediaIncludes.h"
+
+using namespace juce::gl;
+
+SurfaceBatch::SurfaceBatch() :
+	vao(0),
+	vbo(0),
+	ebo(0),
+	ubo(0),
+	vboSize(0),
+	eboSize(0),
+	uboSize(0),
+	blockStride(0)
+{
+}
+
+SurfaceBatch::~SurfaceBatch()
+{
+}
+
+void SurfaceBatch::draw(Screen* screen, const SurfaceShaderLocations& locations)
+{
+	drawnSurfaces.clearQuick();
+	drawnMedias.clearQuick();
+	drawnGeometries.clearQuick();
+
+	for (auto& s : screen->surfaces.items)
+	{
+		Media* m = s->getDrawMedia();
+		if (m == nullptr) continue;
+
+		//newest mesh published by the builder, a surface without one yet is skipped for this frame
+		std::shared_ptr<const SurfaceGeometry> g = s->getGeometry();
+		if (g == nullptr) continue;
+
+		drawnSurfaces.add(s);
+		drawnMedias.add(m);
+		drawnGeometries.add(g);
+	}
+
+	if (vao == 0) initGL(locations);
+
+	//the element buffer is part of the VAO state
+	glBindVertexArray(vao);
+	update();
+
+	int runStart = 0;
+	GLuint runTexture = 0;
+	GLuint runMask = 0;
+
+	for (int i = 0; i < drawnSurfaces.size(); i++)
+	{
+		GLuint texture = drawnMedias[i]->getTextureID();
+		GLuint maskTexture = drawnSurfaces[i]->getMaskTextureID();
+		if (maskTexture == 0) maskTexture = GlContextHolder::getInstance()->getWhiteTextureID();
+
+		//a run can't cross a parameter block, its surfaces index the block bound for the draw
+		bool sameRun = i > runStart && texture == runTexture && maskTexture == runMask && i % maxSurfacesPerBlock != 0;
+		if (!sameRun)
+		{
+			if (i > runStart) drawRange(runStart, i - 1, runTexture, runMask);
+			runStart = i;
+			runTexture = texture;
+			runMask = maskTexture;
+		}
+	}
+
+	if (drawnSurfaces.size() > runStart) drawRange(runStart, drawnSurfaces.size() - 1, runTexture, runMask);
+
+	glBindVertexArray(0);
+
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	glGetError();
+}
+
+void SurfaceBatch::drawRange(int firstEntry, int lastEntry, GLuint texture, GLuint maskTexture)
+{
+	const Entry& first = entries.getReference(firstEntry);
+	const Entry& last = entries.getReference(lastEntry);
+
+	const int numElements = last.firstElement + last.numElements - first.firstElement;
+	if (numElements <= 0) return;
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, maskTexture);
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, texture);
+
+	const int block = firstEntry / maxSurfacesPerBlock;
+	glBindBufferRange(GL_UNIFORM_BUFFER, paramsBindingPoint, ubo, block * blockStride, maxSurfacesPerBlock * sizeof(SurfaceParams));
+
+	glDrawElements(GL_TRIANGLES, numElements, GL_UNSIGNED_INT, (void*)(first.firstElement * sizeof(GLuint)));
+}
+
+void SurfaceBatch::initGL(const SurfaceShaderLocations& locations)
+{
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+	glGenBuffers(1, &ebo);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+
+	const int stride = floatsPerVertex * sizeof(GLfloat);
+	glVertexAttribPointer(locations.position, 2, GL_FLOAT, GL_FALSE, stride, 0);
+	glVertexAttribPointer(locations.surfacePosition, 2, GL_FLOAT, GL_FALSE, stride, (void*)(2 * sizeof(GLfloat)));
+	glVertexAttribPointer(locations.texcoord, 3, GL_FLOAT, GL_FALSE, stride, (void*)(4 * sizeof(GLfloat)));
+	glVertexAttribPointer(locations.maskcoord, 3, GL_FLOAT, GL_FALSE, stride, (void*)(7 * sizeof(GLfloat)));
+	glVertexAttribPointer(locations.surfaceIndex, 1, GL_FLOAT, GL_FALSE, stride, (void*)(surfaceFloatsPerVertex * sizeof(GLfloat)));
+
+	glEnableVertexAttribArray(locations.position);
+	glEnableVertexAttribArray(locations.surfacePosition);
+	glEnableVertexAttribArray(locations.texcoord);
+	glEnableVertexAttribArray(locations.maskcoord);
+	glEnableVertexAttribArray(locations.surfaceIndex);
+	glGetError();
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glGenBuffers(1, &ubo);
+
+	GLint alignment = 256;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	const int blockSize = maxSurfacesPerBlock * sizeof(SurfaceParams);
+	blockStride = ((blockSize + alignment - 1) / alignment) * alignment;
+
+	//make sure the first draw uploads everything
+	vboSize = 0;
+	eboSize = 0;
+	uboSize = 0;
+	entries.clear();
+}
+
+void SurfaceBatch::update()
+{
+	if (drawnSurfaces.size() != entries.size())
+	{
+		rebuild();
+		return;
+	}
+
+	for (int i = 0; i < drawnSurfaces.size(); i++)
+	{
+		if (entries.getReference(i).surface.get() != drawnSurfaces[i])
+		{
+			rebuild();
+			return;
+		}
+	}
+
+	//same surfaces in the same order, only send the ranges of the ones that changed
+	int firstVertex = INT32_MAX, lastVertex = -1;
+	int firstElement = INT32_MAX, lastElement = -1;
+	int firstParams = INT32_MAX, lastParams = -1;
+
+	for (int i = 0; i < drawnSurfaces.size(); i++)
+	{
+		Surface* s = drawnSurfaces[i];
+		Entry& e = entries.getReference(i);
+
+		if (e.geometry != drawnGeometries[i])
+		{
+			if (!copySurfaceVertices(i))
+			{
+				rebuild(); //mesh size changed, offsets of all the following surfaces move
+				return;
+			}
+
+			firstVertex = jmin(firstVertex, e.firstVertex);
+			lastVertex = jmax(lastVertex, e.firstVertex + e.numVertices);
+			firstElement = jmin(firstElement, e.firstElement);
+			lastElement = jmax(lastElement, e.firstElement + e.numElements);
+		}
+
+		if (e.paramsVersion != s->paramsVersion)
+		{
+			writeParams(s, i);
+			const int offset = (i / maxSurfacesPerBlock) * blockStride + (i % maxSurfacesPerBlock) * sizeof(SurfaceParams);
+			firstParams = jmin(firstParams, offset);
+			lastParams = jmax(lastParams, offset + (int)sizeof(SurfaceParams));
+		}
+	}
+
+	if (lastVertex > firstVertex)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		glBufferSubData(GL_ARRAY_BUFFER, firstVertex * floatsPerVertex * sizeof(GLfloat), (lastVertex - firstVertex) * floatsPerVertex * sizeof(GLfloat), vertices.getRawDataPointer() + firstVertex * floatsPerVertex);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	if (lastElement > firstElement)
+	{
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, firstElement * sizeof(GLuint), (lastElement - firstElement) * sizeof(GLuint), elements.getRawDataPointer() + firstElement);
+	}
+
+	if (lastParams > firstParams)
+	{
+		glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+		glBufferSubData(GL_UNIFORM_BUFFER, firstParams, lastParams - firstParams, (char*)paramsData.getData() + firstParams);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+}
+
+void SurfaceBatch::rebuild()
+{
+	entries.clearQuick();
+	vertices.clearQuick();
+	elements.clearQuick();
+
+	const int numBlocks = jmax(1, (drawnSurfaces.size() + maxSurfacesPerBlock - 1) / maxSurfacesPerBlock);
+	paramsData.setSize(numBlocks * blockStride, true);
+
+	for (int i = 0; i < drawnSurfaces.size(); i++)
+	{
+		Surface* s = drawnSurfaces[i];
+		const SurfaceGeometry* g = drawnGeometries[i].get();
+
+		Entry e;
+		e.surface = s;
+		e.firstVertex = vertices.size() / floatsPerVertex;
+		e.numVertices = g->vertices.size() / surfaceFloatsPerVertex;
+		e.firstElement = elements.size();
+		e.numElements = g->elements.size();
+		entries.add(e);
+
+		vertices.resize(vertices.size() + e.numVertices * floatsPerVertex);
+		elements.resize(elements.size() + e.numElements);
+
+		copySurfaceVertices(i);
+		writeParams(s, i);
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	const int verticesSize = vertices.size() * sizeof(GLfloat);
+	if (verticesSize > vboSize)
+	{
+		vboSize = verticesSize;
+		glBufferData(GL_ARRAY_BUFFER, vboSize, vertices.getRawDataPointer(), GL_DYNAMIC_DRAW);
+	}
+	else if (verticesSize > 0) glBufferSubData(GL_ARRAY_BUFFER, 0, verticesSize, vertices.getRawDataPointer());
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	const int elementsSize = elements.size() * sizeof(GLuint);
+	if (elementsSize > eboSize)
+	{
+		eboSize = elementsSize;
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, eboSize, elements.getRawDataPointer(), GL_DYNAMIC_DRAW);
+	}
+	else if (elementsSize > 0) glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, elementsSize, elements.getRawDataPointer());
+
+	glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+	if ((int)paramsData.getSize() > uboSize)
+	{
+		uboSize = (int)paramsData.getSize();
+		glBufferData(GL_UNIFORM_BUFFER, uboSize, paramsData.getData(), GL_DYNAMIC_DRAW);
+	}
+	else glBufferSubData(GL_UNIFORM_BUFFER, 0, paramsData.getSize(), paramsData.getData());
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+bool SurfaceBatch::copySurfaceVertices(int index)
+{
+	Entry& e = entries.getReference(index);
+	const std::shared_ptr<const SurfaceGeometry>& g = drawnGeometries.getReference(index);
+
+	if (g->vertices.size() != e.numVertices * surfaceFloatsPerVertex || g->elements.size() != e.numElements) return false;
+
+	const GLfloat slot = (GLfloat)(index % maxSurfacesPerBlock);
+	const GLfloat* src = g->vertices.getRawDataPointer();
+	GLfloat* dst = vertices.getRawDataPointer() + e.firstVertex * floatsPerVertex;
+	for (int i = 0; i < e.numVertices; i++)
+	{
+		memcpy(dst, src, surfaceFloatsPerVertex * sizeof(GLfloat));
+		dst[surfaceFloatsPerVertex] = slot;
+		src += surfaceFloatsPerVertex;
+		dst += floatsPerVertex;
+	}
+
+	GLuint* el = elements.getRawDataPointer() + e.firstElement;
+	for (int i = 0; i < e.numElements; i++) el[i] = g->elements.getUnchecked(i) + e.firstVertex;
+
+	e.geometry = g;
+	return true;
+}
+
+void SurfaceBatch::writeParams(Surface* s, int index)
+{
+	const int offset = (index / maxSurfacesPerBlock) * blockStride + (index % maxSurfacesPerBlock) * sizeof(SurfaceParams);
+	s->fillParams(*(SurfaceParams*)((char*)paramsData.getData() + offset));
+	entries.getReference(index).paramsVersion = s->paramsVersion;
+}
+
+void SurfaceBatch::release()
+{
+	if (vao != 0) glDeleteVertexArrays(1, &vao);
+	if (vbo != 0) glDeleteBuffers(1, &vbo);
+	if (ebo != 0) glDeleteBuffers(1, &ebo);
+	if (ubo != 0) glDeleteBuffers(1, &ubo);
+
+	vao = 0;
+	vbo = 0;
+	ebo = 0;
+	ubo = 0;
+	vboSize = 0;
+	eboSize = 0;
+	uboSize = 0;
+	entries.clear();
+	drawnGeometries.clear();
+}
@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+	SurfaceBatch.h
+	Created: 17 Oct 2026 3:12:54pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Draws all the surfaces of a screen from one merged mesh.
+// Each vertex carries the index of its surface, whose parameters are read from a std140 array in one uniform buffer.
+// Surfaces are still drawn in order for blending, consecutive surfaces showing the same media and mask share a draw call,
+// so a wall of surfaces cut from a single media is one glDrawElements. Buffers are only rewritten where surfaces changed.
+class SurfaceBatch
+{
+public:
+	SurfaceBatch();
+	~SurfaceBatch();
+
+	//128 bytes per surface, fills the 16KB block size every GL3 driver supports. Bigger screens use several blocks.
+	static const int maxSurfacesPerBlock = 128;
+	static const int surfaceFloatsPerVertex = 10; //position, surface position, texture and mask coordinates
+	static const int floatsPerVertex = surfaceFloatsPerVertex + 1; //+ surface index
+	static const GLuint paramsBindingPoint = 1;
+
+	struct Entry
+	{
+		WeakReference<Inspectable> surface;
+		std::shared_ptr<const SurfaceGeometry> geometry; //snapshot copied in the merged mesh
+		unsigned int paramsVersion;
+		int firstVertex;
+		int numVertices;
+		int firstElement;
+		int numElements;
+	};
+
+	GLuint vao;
+	GLuint vbo;
+	GLuint ebo;
+	GLuint ubo;
+	int vboSize;
+	int eboSize;
+	int uboSize;
+	int blockStride; //bytes between two blocks of parameters, rounded to the driver's offset alignment
+
+	Array<Entry> entries;
+	Array<GLfloat> vertices;
+	Array<GLuint> elements;
+	MemoryBlock paramsData;
+
+	Array<Surface*> drawnSurfaces;
+	Array<Media*> drawnMedias;
+	Array<std::shared_ptr<const SurfaceGeometry>> drawnGeometries;
+
+	//GL thread
+	void draw(Screen* screen, const SurfaceShaderLocations& locations);
+	void release();
+
+private:
+	void initGL(const SurfaceShaderLocations& locations);
+	void update();
+	void rebuild();
+	bool copySurfaceVertices(int index);
+	void writeParams(Surface* s, int index);
+	void drawRange(int firstEntry, int lastEntry, GLuint texture, GLuint maskTexture);
+};
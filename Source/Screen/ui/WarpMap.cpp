@@ -0,0 +1,294 @@
+/*
+  ==============================================================================
+
+	WarpMap.cpp
+	Created: 17 Oct 2026 9:04:51pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Screen/ScreenIncludes.h"
+#include "Common/CommonIncludes.h"
+#include "Media/MediaIncludes.h"
+
+using namespace juce::gl;
+
+WarpMap::WarpMap() :
+	fbo(0),
+	warpTexture(0),
+	maskTexture(0),
+	width(0),
+	height(0),
+	vao(0),
+	vbo(0),
+	groupIdLocation(-1)
+{
+}
+
+WarpMap::~WarpMap()
+{
+}
+
+void WarpMap::bake(Screen* screen, OpenGLShaderProgram* bakeShader, const SurfaceShaderLocations& locations)
+{
+	currentSurfaces.clearQuick();
+
+	for (auto& s : screen->surfaces.items)
+	{
+		Media* m = s->getDrawMedia();
+		if (m == nullptr) continue;
+
+		std::shared_ptr<const SurfaceGeometry> g = s->getGeometry();
+		if (g == nullptr) continue;
+
+		Media* mask = s->showTestPattern->boolValue() ? nullptr : s->mask->getTargetContainerAs<Media>();
+		GLuint alphaTexture = s->isAlphaPrecomputed() ? s->alphaTexture : 0;
+		currentSurfaces.add({ s, g, s->paramsVersion, m, mask, alphaTexture });
+	}
+
+	const int w = screen->screenWidth->intValue();
+	const int h = screen->screenHeight->intValue();
+	const bool sizeChanged = fbo == 0 || w != width || h != height;
+
+	if (!sizeChanged && currentSurfaces == bakedSurfaces) return;
+	if (sizeChanged && !initGL(w, h)) return;
+
+	bakedSurfaces = currentSurfaces;
+	groups.clearQuick();
+
+	GLint previousFBO = 0;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFBO);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+	glViewport(0, 0, width, height);
+	glClearColor(0, 0, 0, 0);
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	//the map holds coordinates, not colors, the last surface drawn on a pixel owns it
+	glDisable(GL_BLEND);
+
+	bakeShader->use();
+	GLint bakeIdLocation = glGetUniformLocation(bakeShader->getProgramID(), "bakeId");
+
+	for (auto& b : bakedSurfaces)
+	{
+		int groupIndex = -1;
+		for (int i = 0; i < groups.size() && groupIndex == -1; i++)
+		{
+			if (groups[i].media == b.media && groups[i].mask == b.mask && groups[i].alphaTexture == b.alphaTexture) groupIndex = i;
+		}
+
+		if (groupIndex == -1)
+		{
+			groups.add({ b.media, b.mask, b.alphaTexture, b.surface });
+			groupIndex = groups.size() - 1;
+		}
+
+		//0 is left for the pixels without any surface
+		glUniform1f(bakeIdLocation, (GLfloat)(groupIndex + 1));
+		b.surface->drawGeometry(locations);
+	}
+
+	glUseProgram(0);
+	glEnable(GL_BLEND);
+	glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
+	glGetError();
+}
+
+void WarpMap::draw()
+{
+	if (fbo == 0 || groups.isEmpty() || lookupShader == nullptr) return;
+
+	lookupShader->use();
+
+	glActiveTexture(GL_TEXTURE2);
+	glBindTexture(GL_TEXTURE_2D, warpTexture);
+	glActiveTexture(GL_TEXTURE3);
+	glBindTexture(GL_TEXTURE_2D, maskTexture);
+
+	glBindVertexArray(vao);
+
+	for (int i = 0; i < groups.size(); i++)
+	{
+		const Group& g = groups.getReference(i);
+
+		glActiveTexture(GL_TEXTURE0);
+		GLuint maskID = g.surface->getMaskTextureID();
+		glBindTexture(GL_TEXTURE_2D, maskID != 0 ? maskID : GlContextHolder::getInstance()->getWhiteTextureID());
+
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, g.media->getTextureID());
+
+		glUniform1f(groupIdLocation, (GLfloat)(i + 1));
+		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	}
+
+	glBindVertexArray(0);
+
+	for (GLenum unit : { GL_TEXTURE3, GL_TEXTURE2, GL_TEXTURE1, GL_TEXTURE0 })
+	{
+		glActiveTexture(unit);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	glUseProgram(0);
+	glGetError();
+}
+
+bool WarpMap::initGL(int w, int h)
+{
+	releaseTargets();
+
+	if (lookupShader == nullptr && !initLookup()) return false;
+
+	//float targets, 8 bits would not address more than 256 texels of a media
+	GLuint textures[2];
+	glGenTextures(2, textures);
+	warpTexture = textures[0];
+	maskTexture = textures[1];
+
+	for (GLuint t : textures)
+	{
+		glBindTexture(GL_TEXTURE_2D, t);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, w, h, 0, GL_RGBA, GL_FLOAT, nullptr);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	GLint previousFBO = 0;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFBO);
+
+	glGenFramebuffers(1, &fbo);
+	glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, warpTexture, 0);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, maskTexture, 0);
+	GLenum buffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+	glDrawBuffers(2, buffers);
+
+	const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+	glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
+
+	if (!complete)
+	{
+		LOGERROR("Warp map : float render targets are not supported by this driver");
+		releaseTargets();
+		return false;
+	}
+
+	width = w;
+	height = h;
+	bakedSurfaces.clear();
+	return true;
+}
+
+bool WarpMap::initLookup()
+{
+	const String vertexShader = R"(
+		attribute vec2 position;
+
+		varying vec2 mapCoord;
+
+		void main()
+		{
+			mapCoord = position * 0.5 + 0.5;
+			gl_Position = vec4(position, 0.0, 1.0);
+		}
+	)";
+
+	//same output as the surface shader, with the geometry read from the map
+	const String fragmentShader = R"(
+		varying vec2 mapCoord;
+
+		uniform sampler2D mask;
+		uniform sampler2D tex;
+		uniform sampler2D warpMap;
+		uniform sampler2D warpMaskMap;
+		uniform float groupId;
+
+		void main()
+		{
+			vec4 warp = texture2D(warpMap, mapCoord);
+			if (abs(warp.a - groupId) > 0.5) discard;
+
+			vec4 warpMask = texture2D(warpMaskMap, mapCoord);
+			vec4 color = texture2D(tex, warp.xy);
+			if (warp.x > 1.0 || warp.x < 0.0 || warp.y > 1.0 || warp.y < 0.0) color = vec4(0.0);
+
+			float maskValue = texture2D(mask, warpMask.xy).g;
+			if (warpMask.z > 0.5) maskValue = 1.0 - maskValue;
+
+			color.a = warp.z * maskValue;
+			gl_FragColor = color;
+		}
+	)";
+
+	lookupShader.reset(new OpenGLShaderProgram(GlContextHolder::getInstance()->getCurrentContext()));
+	if (!lookupShader->addVertexShader(OpenGLHelpers::translateVertexShaderToV3(vertexShader))
+		|| !lookupShader->addFragmentShader(OpenGLHelpers::translateFragmentShaderToV3(fragmentShader))
+		|| !lookupShader->link())
+	{
+		LOGERROR("Warp map : error compiling shader : " << lookupShader->getLastError());
+		lookupShader.reset();
+		return false;
+	}
+
+	GLuint programID = lookupShader->getProgramID();
+	lookupShader->use();
+	glUniform1i(glGetUniformLocation(programID, "mask"), 0);
+	glUniform1i(glGetUniformLocation(programID, "tex"), 1);
+	glUniform1i(glGetUniformLocation(programID, "warpMap"), 2);
+	glUniform1i(glGetUniformLocation(programID, "warpMaskMap"), 3);
+	groupIdLocation = glGetUniformLocation(programID, "groupId");
+	glUseProgram(0);
+
+	//fullscreen quad
+	const GLfloat quad[8] = { -1, -1, 1, -1, -1, 1, 1, 1 };
+
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+
+	GLint posAttrib = glGetAttribLocation(programID, "position");
+	glEnableVertexAttribArray(posAttrib);
+	glVertexAttribPointer(posAttrib, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), 0);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	return true;
+}
+
+void WarpMap::releaseTargets()
+{
+	if (fbo != 0) glDeleteFramebuffers(1, &fbo);
+	if (warpTexture != 0) glDeleteTextures(1, &warpTexture);
+	if (maskTexture != 0) glDeleteTextures(1, &maskTexture);
+
+	fbo = 0;
+	warpTexture = 0;
+	maskTexture = 0;
+	width = 0;
+	height = 0;
+	groups.clear();
+}
+
+void WarpMap::release()
+{
+	releaseTargets();
+
+	if (vao != 0) glDeleteVertexArrays(1, &vao);
+	if (vbo != 0) glDeleteBuffers(1, &vbo);
+	lookupShader.reset();
+
+	vao = 0;
+	vbo = 0;
+	groupIdLocation = -1;
+	bakedSurfaces.clear();
+	currentSurfaces.clear();
+}
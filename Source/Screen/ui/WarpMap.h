@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+	WarpMap.h
+	Created: 17 Oct 2026 9:04:51pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Baked geometry of a whole screen, for outputs with many dense warped surfaces.
+// The meshes are drawn once into two float textures at the screen resolution : media coordinates, soft edges and the
+// id of the surface group, then mask coordinates and mask inversion. Every frame only draws one fullscreen pass per
+// group of surfaces sharing a media and mask, reading the medias through the map, so the cost no longer depends on
+// the meshes. The map is baked again when a surface mesh, parameter, media or the screen size changes.
+// Overlapping surfaces are not blended together, the last one in the list covers the others.
+class WarpMap
+{
+public:
+	WarpMap();
+	~WarpMap();
+
+	struct BakedSurface
+	{
+		Surface* surface;
+		std::shared_ptr<const SurfaceGeometry> geometry;
+		unsigned int paramsVersion;
+		Media* media;
+		Media* mask;
+		GLuint alphaTexture; //precomputed alpha of the surface, 0 if it reads its mask
+
+		bool operator==(const BakedSurface& o) const
+		{
+			return surface == o.surface && geometry == o.geometry && paramsVersion == o.paramsVersion && media == o.media && mask == o.mask && alphaTexture == o.alphaTexture;
+		}
+	};
+
+	struct Group
+	{
+		Media* media;
+		Media* mask;
+		GLuint alphaTexture;
+		Surface* surface; //first surface of the group, gives the mask texture
+	};
+
+	GLuint fbo;
+	GLuint warpTexture;
+	GLuint maskTexture;
+	int width;
+	int height;
+
+	GLuint vao;
+	GLuint vbo;
+	std::unique_ptr<OpenGLShaderProgram> lookupShader;
+	GLint groupIdLocation;
+
+	Array<BakedSurface> bakedSurfaces;
+	Array<BakedSurface> currentSurfaces;
+	Array<Group> groups;
+
+	//GL thread. bake() is called outside of any render target, draw() on the screen frame buffer
+	void bake(Screen* screen, OpenGLShaderProgram* bakeShader, const SurfaceShaderLocations& locations);
+	void draw();
+	void release();
+
+private:
+	bool initGL(int w, int h);
+	bool initLookup();
+	void releaseTargets();
+};
@@ -12,4 +12,6 @@
 
 #include "Main.cpp"
 #include "MainComponent.cpp"
-#include "MainComponentCommands.cpp"
\ No newline at end of file
+#include "MainComponentCommands.cpp"
+
+#include "Engine/RMPBenchmark.cpp"
\ No newline at end of file